@@ -0,0 +1,29 @@
+/**
+ * @file bench_symbols.cpp
+ * @brief A library exporting the symbols resolved by the benchmarks.
+ */
+
+#define MI_BENCH_SYMBOL(index)                                                           \
+    extern "C" int bench_symbol_##index()                                                \
+    {                                                                                    \
+        return index;                                                                    \
+    }
+
+#define MI_BENCH_SYMBOLS_8(prefix)                                                       \
+    MI_BENCH_SYMBOL(prefix##0)                                                           \
+    MI_BENCH_SYMBOL(prefix##1)                                                           \
+    MI_BENCH_SYMBOL(prefix##2)                                                           \
+    MI_BENCH_SYMBOL(prefix##3)                                                           \
+    MI_BENCH_SYMBOL(prefix##4)                                                           \
+    MI_BENCH_SYMBOL(prefix##5)                                                           \
+    MI_BENCH_SYMBOL(prefix##6)                                                           \
+    MI_BENCH_SYMBOL(prefix##7)
+
+MI_BENCH_SYMBOLS_8(1)
+MI_BENCH_SYMBOLS_8(2)
+MI_BENCH_SYMBOLS_8(3)
+MI_BENCH_SYMBOLS_8(4)
+MI_BENCH_SYMBOLS_8(5)
+MI_BENCH_SYMBOLS_8(6)
+MI_BENCH_SYMBOLS_8(7)
+MI_BENCH_SYMBOLS_8(8)
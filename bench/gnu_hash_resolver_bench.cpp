@@ -0,0 +1,111 @@
+/**
+ * @file gnu_hash_resolver_bench.cpp
+ * @brief Compares symbol lookups through the platform loader
+ *        with lookups through the gnu_hash_resolver.
+ *
+ * Every thread resolves all symbols of the benchmark library in turn,
+ * the time per lookup is printed for one thread and for every core.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mi/gnu_hash_resolver.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/**
+ * @brief The number of lookups done by every thread.
+ */
+constexpr std::size_t LOOKUPS = 1000000;
+
+/**
+ * @brief Runs a lookup function on a number of threads.
+ * @return The time taken per lookup, in nanoseconds.
+ */
+double
+measure(std::size_t                                      threads,
+        const std::vector<std::string>                  &names,
+        const std::function<void *(const std::string &)> &lookup)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (std::size_t thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back(
+            [&names, &lookup]()
+            {
+                for (std::size_t index = 0; index < LOOKUPS; ++index)
+                {
+                    if (lookup(names[index % names.size()]) == nullptr)
+                    {
+                        std::fputs("symbol not found\n", stderr);
+                        std::abort();
+                    }
+                }
+            });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           static_cast<double>(LOOKUPS * threads);
+}
+
+} // namespace
+
+int
+main()
+{
+    mi::dl::dynamic_library library(MI_BENCH_SYMBOLS_PATH);
+    library.load();
+
+    const mi::dl::gnu_hash_resolver resolver(library);
+    if (!resolver.is_indexed())
+    {
+        std::fputs("the benchmark library has no GNU hash table\n", stderr);
+        return 1;
+    }
+
+    std::vector<std::string> names;
+    for (int prefix = 1; prefix <= 8; ++prefix)
+    {
+        for (int index = 0; index < 8; ++index)
+        {
+            names.push_back("bench_symbol_" + std::to_string(prefix * 10 + index));
+        }
+    }
+
+    const auto platform = [&library](const std::string &name)
+    {
+        return reinterpret_cast<void *>(library.sym_unsafe(name));
+    };
+    const auto indexed = [&resolver](const std::string &name)
+    {
+        return reinterpret_cast<void *>(resolver.resolve(name));
+    };
+
+    std::vector<std::size_t> counts = {1};
+    if (const std::size_t cores = std::thread::hardware_concurrency(); cores > 1)
+    {
+        counts.push_back(cores);
+    }
+
+    for (const auto threads : counts)
+    {
+        std::printf("%zu thread(s): dlsym %.1f ns, gnu_hash_resolver %.1f ns per lookup\n",
+                    threads,
+                    measure(threads, names, platform),
+                    measure(threads, names, indexed));
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file async_operation.hpp
+ * @brief Defines the async_operation class, an awaitable running
+ *        an operation on an executor.
+ */
+
+#ifndef MI_ASYNC_OPERATION_HPP
+#define MI_ASYNC_OPERATION_HPP
+
+#include "executor.hpp"
+#include <coroutine>
+#include <exception>
+#include <functional>
+
+namespace mi
+{
+
+/**
+ * @class async_operation
+ * @brief An awaitable that runs an operation on an executor.
+ *
+ * Nothing happens until the operation is awaited. The awaiting coroutine is
+ * then suspended, the operation is submitted to the executor and the
+ * coroutine resumes on the executor thread once the operation returned.
+ * An exception thrown by the operation is rethrown from the co_await.
+ *
+ * @code
+ * co_await module.async_load(pool);
+ * @endcode
+ */
+class async_operation
+{
+public:
+    /**
+     * @typedef operation_t
+     * @brief The type of the operation run by the awaitable.
+     */
+    using operation_t = std::function<void()>;
+
+    /**
+     * @brief Always suspends the awaiting coroutine.
+     * @return `false`.
+     */
+    [[nodiscard]]
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @brief Submits the operation, the coroutine is resumed once it returned.
+     * @param coroutine The awaiting coroutine.
+     */
+    void
+    await_suspend(std::coroutine_handle<> coroutine)
+    {
+        m_executor.submit(
+            [this, coroutine]()
+            {
+                try
+                {
+                    m_operation();
+                }
+                catch (...)
+                {
+                    m_error = std::current_exception();
+                }
+                coroutine.resume();
+            });
+    }
+
+    /**
+     * @brief Completes the co_await.
+     * @throw Any exception thrown by the operation.
+     */
+    void
+    await_resume() const
+    {
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    /**
+     * @brief Constructs an awaitable for an operation.
+     *
+     * @param executor The executor running the operation,
+     *                 it must outlive the co_await.
+     *
+     * @param operation The operation to run.
+     */
+    async_operation(executor &executor, operation_t operation)
+        : m_executor(executor),
+          m_operation(std::move(operation))
+    {
+    }
+
+private:
+    executor          &m_executor;  ///< Runs the operation.
+    operation_t        m_operation; ///< The awaited operation.
+    std::exception_ptr m_error;     ///< Thrown by the operation.
+};
+
+} // namespace mi
+
+#endif /* MI_ASYNC_OPERATION_HPP */
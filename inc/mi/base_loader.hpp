@@ -9,8 +9,19 @@
 #ifndef MI_BASE_LOADER_HPP
 #define MI_BASE_LOADER_HPP
 
+#include "epoch.hpp"
 #include "filter.hpp"
 #include "unique_container.hpp"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 namespace mi
 {
@@ -22,12 +33,316 @@ namespace mi
  * The loader class template is a specialized unique_container with an overridden
  * destructor that ensures all contained elements are properly destroyed in reverse order.
  *
+ * The container is inherited protected: objects are only attached through
+ * make_unique() and emplace_unique(), which publish them, and the owning
+ * pointers cannot be reset or replaced from outside, so that objects
+ * referenced by snapshots are never detached.
+ *
+ * Objects attached through the loader are also published in an immutable
+ * snapshot of the list, which other threads iterate through view() without
+ * locking while objects are being attached. Every attach publishes a new
+ * snapshot, replaced ones are destroyed by the epoch_domain once no reader
+ * holds them anymore. Snapshots index the objects by their dynamic type and
+ * by the name derived loaders give them with index_name(), so find() and
+ * find_named() answer in constant time.
+ *
  * @tparam ValueType The type of elements stored in the loader container.
  */
 template <typename ValueType>
-class base_loader : public unique_container<ValueType>
+class base_loader : protected unique_container<ValueType>
 {
+    using base_type = unique_container<ValueType>; ///< The container of the objects.
+
 public:
+    using typename base_type::const_iterator;
+    using typename base_type::const_reverse_iterator;
+    using typename base_type::size_type;
+
+    using base_type::empty;
+    using base_type::exists;
+    using base_type::get;
+    using base_type::has_value;
+    using base_type::is_value_null;
+    using base_type::size;
+    using base_type::operator();
+
+    /**
+     * @brief Returns an iterator to the first owning pointer.
+     */
+    [[nodiscard]]
+    const_iterator
+    begin() const noexcept
+    {
+        return base_type::begin();
+    }
+
+    /**
+     * @brief Returns an iterator past the last owning pointer.
+     */
+    [[nodiscard]]
+    const_iterator
+    end() const noexcept
+    {
+        return base_type::end();
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the last owning pointer.
+     */
+    [[nodiscard]]
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return base_type::rbegin();
+    }
+
+    /**
+     * @brief Returns a reverse iterator before the first owning pointer.
+     */
+    [[nodiscard]]
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return base_type::rend();
+    }
+
+    /**
+     * @struct name_hash
+     * @brief Hashes names, so that the index is searched by string views.
+     */
+    struct name_hash
+    {
+        using is_transparent = void;
+
+        std::size_t
+        operator()(std::string_view name) const noexcept
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    /**
+     * @struct snapshot_type
+     * @brief The immutable list of objects published by the loader.
+     */
+    struct snapshot_type
+    {
+        std::vector<ValueType *> objects; ///< The objects in attach order.
+        std::unordered_map<std::type_index, std::vector<ValueType *>>
+            types; ///< The objects by dynamic type, in attach order.
+        std::unordered_multimap<std::string, ValueType *, name_hash, std::equal_to<>>
+            names; ///< The objects by the name they are indexed by.
+    };
+
+    /**
+     * @typedef iterator_type
+     * @brief Iterates over the objects of a snapshot.
+     */
+    using iterator_type = typename std::vector<ValueType *>::const_iterator;
+
+    /**
+     * @class snapshot_view
+     * @brief A snapshot of the objects, valid as long as the view exists.
+     *
+     * The view holds an epoch_guard and should be short-lived, snapshots
+     * replaced in the meantime are not destroyed while it exists.
+     */
+    class snapshot_view : private mixin::noncopyable, private mixin::nonmovable
+    {
+    public:
+        /**
+         * @brief Returns an iterator to the first object.
+         */
+        [[nodiscard]]
+        iterator_type
+        begin() const noexcept
+        {
+            return m_list != nullptr ? m_list->objects.begin() : iterator_type();
+        }
+
+        /**
+         * @brief Returns an iterator past the last object.
+         */
+        [[nodiscard]]
+        iterator_type
+        end() const noexcept
+        {
+            return m_list != nullptr ? m_list->objects.end() : iterator_type();
+        }
+
+        /**
+         * @brief Returns the number of objects in the snapshot.
+         */
+        [[nodiscard]]
+        std::size_t
+        size() const noexcept
+        {
+            return m_list != nullptr ? m_list->objects.size() : 0;
+        }
+
+        /**
+         * @brief Checks whether the snapshot holds no object.
+         */
+        [[nodiscard]]
+        bool
+        empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Returns the object at an index.
+         * @param index The index, it must be lower than size().
+         */
+        [[nodiscard]]
+        ValueType *
+        operator[](std::size_t index) const noexcept
+        {
+            return m_list->objects[index];
+        }
+
+        /**
+         * @brief Returns the objects of a dynamic type.
+         * @param type The exact type of the objects, base classes do not match.
+         * @return The objects in attach order, valid as long as the view exists.
+         */
+        [[nodiscard]]
+        std::span<ValueType *const>
+        of_type(std::type_index type) const noexcept
+        {
+            if (m_list != nullptr)
+            {
+                if (auto found = m_list->types.find(type); found != m_list->types.end())
+                {
+                    return found->second;
+                }
+            }
+            return {};
+        }
+
+        /**
+         * @brief Returns an object indexed by a name.
+         * @param name The name of the object.
+         * @return The object, or nullptr if no object has the name.
+         *         If several objects share the name, any one of them.
+         */
+        [[nodiscard]]
+        ValueType *
+        named(std::string_view name) const noexcept
+        {
+            if (m_list != nullptr)
+            {
+                if (auto found = m_list->names.find(name); found != m_list->names.end())
+                {
+                    return found->second;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Enters a read-side section and loads the published snapshot.
+         * @param published The pointer to the published snapshot.
+         */
+        explicit snapshot_view(
+            const std::atomic<const snapshot_type *> &published) noexcept
+            : m_list(published.load(std::memory_order_acquire))
+        {
+        }
+
+    private:
+        epoch_guard          m_guard; ///< Keeps the snapshot alive, entered first.
+        const snapshot_type *m_list;  ///< The snapshot, nullptr if nothing was attached.
+    };
+
+    /**
+     * @brief Returns the objects attached so far, without locking.
+     *
+     * Safe to call while other threads attach objects. Objects attached after
+     * the call are not part of the view.
+     *
+     * @return The view of the current snapshot.
+     */
+    [[nodiscard]]
+    snapshot_view
+    view() const noexcept
+    {
+        return snapshot_view(m_snapshot);
+    }
+
+    /**
+     * @brief Returns the first attached object of a type, without locking.
+     *
+     * Objects are never detached, so the pointer stays valid as long as the
+     * loader exists, unlike the index of the object it can be kept.
+     *
+     * @tparam CustomType The exact type of the object, base classes do not match.
+     * @return The object, or nullptr if no object of the type is attached.
+     */
+    template <typename CustomType>
+    [[nodiscard]]
+    CustomType *
+    find() const noexcept
+    {
+        const auto view    = this->view();
+        const auto objects = view.of_type(typeid(CustomType));
+        return objects.empty() ? nullptr : static_cast<CustomType *>(objects.front());
+    }
+
+    /**
+     * @brief Returns an object indexed by a name, without locking.
+     *
+     * Objects are never detached, so the pointer stays valid as long as the
+     * loader exists.
+     *
+     * @param name The name of the object, see index_name().
+     * @return The object, or nullptr if no object has the name.
+     *         If several objects share the name, any one of them.
+     */
+    [[nodiscard]]
+    ValueType *
+    find_named(std::string_view name) const noexcept
+    {
+        return view().named(name);
+    }
+
+    /**
+     * @brief Constructs an object, appends it and publishes a new snapshot.
+     *
+     * Concurrent calls are serialized.
+     *
+     * @return The index of the object.
+     */
+    template <typename CustomType, typename... Args>
+    size_type
+    make_unique(Args &&...args)
+    {
+        std::lock_guard lock(m_publisher);
+        const auto      index =
+            base_type::template make_unique<CustomType>(std::forward<Args>(args)...);
+        publish(this->get_unsafe(index));
+        return index;
+    }
+
+    /**
+     * @brief Constructs an object, appends it and publishes a new snapshot.
+     *
+     * Concurrent calls are serialized.
+     *
+     * @return A reference to the object.
+     */
+    template <typename CustomType, typename... Args>
+    CustomType &
+    emplace_unique(Args &&...args)
+    {
+        /// The list may be reallocated by another attach once the lock is released.
+        std::lock_guard lock(m_publisher);
+        auto           &object = static_cast<CustomType &>(this->get_unsafe(
+            base_type::template make_unique<CustomType>(std::forward<Args>(args)...)));
+        publish(object);
+        return object;
+    }
+
     /**
      * @brief Destructor that clears the container in reverse order.
      *
@@ -36,13 +351,108 @@ public:
      */
     ~base_loader()
     {
-        filter::iterate(this->rbegin(),
-                        this->rend(),
+        /// No reader may use the loader while it is destroyed.
+        delete m_snapshot.exchange(nullptr, std::memory_order_acq_rel);
+        filter::iterate(base_type::rbegin(),
+                        base_type::rend(),
                         [](auto &object)
                         {
                             object.reset();
                         });
     }
+
+protected:
+    /**
+     * @brief Indexes an attached object by a name and publishes a new snapshot.
+     *
+     * The name replaces the one the object was indexed by before, nothing is
+     * published if it is unchanged. Concurrent calls and attaches are
+     * serialized. Derived loaders call it whenever the name of an object
+     * changes, it is part of the published state rather than of the object.
+     *
+     * @param object The attached object.
+     * @param name The name, or std::nullopt to take the object off the index.
+     */
+    void
+    index_name(ValueType &object, std::optional<std::string_view> name) const
+    {
+        std::lock_guard lock(m_publisher);
+        auto            indexed = m_names.find(&object);
+        if (indexed == m_names.end() ? !name.has_value()
+                                     : name.has_value() && indexed->second == *name)
+        {
+            return;
+        }
+
+        auto *next = copy_snapshot();
+        if (indexed != m_names.end())
+        {
+            auto [first, last] = next->names.equal_range(indexed->second);
+            for (; first != last; ++first)
+            {
+                if (first->second == &object)
+                {
+                    next->names.erase(first);
+                    break;
+                }
+            }
+            m_names.erase(indexed);
+        }
+
+        if (name.has_value())
+        {
+            next->names.emplace(std::string(*name), &object);
+            m_names.emplace(&object, std::string(*name));
+        }
+        replace_snapshot(next);
+    }
+
+private:
+    /**
+     * @brief Copies the published snapshot, to be modified by a writer.
+     * @return The copy, or an empty snapshot if none was published.
+     */
+    snapshot_type *
+    copy_snapshot() const
+    {
+        /// Only writers holding the publisher lock replace the snapshot.
+        const auto *current = m_snapshot.load(std::memory_order_relaxed);
+        return current != nullptr ? new snapshot_type(*current) : new snapshot_type();
+    }
+
+    /**
+     * @brief Publishes a snapshot and retires the replaced one.
+     * @param next The snapshot, owned by the loader from now on.
+     */
+    void
+    replace_snapshot(snapshot_type *next) const
+    {
+        /// Sequentially consistent, as the epoch_domain expects of unpublishing.
+        if (const auto *previous = m_snapshot.exchange(next))
+        {
+            epoch_domain::instance().retire(const_cast<snapshot_type *>(previous));
+        }
+    }
+
+    /**
+     * @brief Publishes the list with an attached object
+     *        and retires the replaced snapshot.
+     *
+     * @param object The object attached last.
+     */
+    void
+    publish(ValueType &object)
+    {
+        auto *next = copy_snapshot();
+        next->objects.push_back(&object);
+        next->types[typeid(object)].push_back(&object);
+        replace_snapshot(next);
+    }
+
+    mutable std::atomic<const snapshot_type *> m_snapshot{nullptr}; ///< The published list.
+    mutable std::mutex                         m_publisher;         ///< Serializes writers.
+    mutable std::unordered_map<const ValueType *, std::string>
+        m_names; ///< Names the objects are indexed by, guarded by the publisher.
 };
 
 } // namespace mi
@@ -0,0 +1,217 @@
+/**
+ * @file binary_stream.hpp
+ * @brief Defines the binary_reader and binary_writer classes used by the
+ *        binary file formats of the library.
+ *
+ * Values are stored in native byte order, strings are prefixed with their
+ * length as a 32-bit unsigned integer. The files are caches and archives
+ * of the running platform, so no conversion is performed.
+ */
+
+#ifndef MI_BINARY_STREAM_HPP
+#define MI_BINARY_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace mi
+{
+
+/**
+ * @class binary_reader
+ * @brief Reads values from a byte range with bounds checks.
+ *
+ * The first read past the end marks the reader as failed,
+ * later reads then return empty values.
+ */
+class binary_reader
+{
+public:
+    /**
+     * @brief Reads a 32-bit unsigned integer.
+     */
+    std::uint32_t
+    u32() noexcept
+    {
+        return scalar<std::uint32_t>();
+    }
+
+    /**
+     * @brief Reads a 64-bit unsigned integer.
+     */
+    std::uint64_t
+    u64() noexcept
+    {
+        return scalar<std::uint64_t>();
+    }
+
+    /**
+     * @brief Reads a length-prefixed string.
+     * @return A view of the string, pointing into the byte range.
+     */
+    std::string_view
+    string_view() noexcept
+    {
+        const auto size = u32();
+        if (m_failed || size > m_bytes.size() - m_offset)
+        {
+            m_failed = true;
+            return {};
+        }
+
+        const std::string_view value(
+            reinterpret_cast<const char *>(m_bytes.data() + m_offset),
+            size);
+        m_offset += size;
+        return value;
+    }
+
+    /**
+     * @brief Reads a length-prefixed string.
+     * @return A copy of the string.
+     */
+    std::string
+    string()
+    {
+        return std::string(string_view());
+    }
+
+    /**
+     * @brief Checks whether a read went past the end.
+     */
+    [[nodiscard]]
+    bool
+    failed() const noexcept
+    {
+        return m_failed;
+    }
+
+    /**
+     * @brief Checks whether all bytes have been read.
+     */
+    [[nodiscard]]
+    bool
+    at_end() const noexcept
+    {
+        return m_offset == m_bytes.size();
+    }
+
+    /**
+     * @brief Returns the position of the next read.
+     */
+    [[nodiscard]]
+    std::size_t
+    offset() const noexcept
+    {
+        return m_offset;
+    }
+
+    /**
+     * @brief Starts reading at the beginning of the bytes.
+     * @param bytes The bytes to read, they must outlive the reader.
+     */
+    explicit binary_reader(std::span<const std::byte> bytes) noexcept
+        : m_bytes(bytes)
+    {
+    }
+
+private:
+    /**
+     * @brief Reads a trivially copyable value in native byte order.
+     */
+    template <typename Type>
+    Type
+    scalar() noexcept
+    {
+        Type value{};
+        if (m_failed || sizeof(Type) > m_bytes.size() - m_offset)
+        {
+            m_failed = true;
+            return value;
+        }
+
+        std::memcpy(&value, m_bytes.data() + m_offset, sizeof(Type));
+        m_offset += sizeof(Type);
+        return value;
+    }
+
+    std::span<const std::byte> m_bytes;          ///< The bytes read.
+    std::size_t                m_offset = 0;     ///< The position of the next read.
+    bool                       m_failed = false; ///< Set by a read past the end.
+};
+
+/**
+ * @class binary_writer
+ * @brief Appends values to a byte buffer in the layout read by binary_reader.
+ */
+class binary_writer
+{
+public:
+    /**
+     * @brief Appends a 32-bit unsigned integer.
+     */
+    void
+    u32(std::uint32_t value)
+    {
+        scalar(value);
+    }
+
+    /**
+     * @brief Appends a 64-bit unsigned integer.
+     */
+    void
+    u64(std::uint64_t value)
+    {
+        scalar(value);
+    }
+
+    /**
+     * @brief Appends a length-prefixed string.
+     */
+    void
+    string(std::string_view value)
+    {
+        u32(static_cast<std::uint32_t>(value.size()));
+        m_buffer.append(value);
+    }
+
+    /**
+     * @brief Appends raw bytes.
+     */
+    void
+    bytes(std::string_view value)
+    {
+        m_buffer.append(value);
+    }
+
+    /**
+     * @brief Returns the written bytes.
+     */
+    [[nodiscard]]
+    const std::string &
+    buffer() const noexcept
+    {
+        return m_buffer;
+    }
+
+private:
+    /**
+     * @brief Appends a trivially copyable value in native byte order.
+     */
+    template <typename Type>
+    void
+    scalar(Type value)
+    {
+        m_buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    std::string m_buffer; ///< The written bytes.
+};
+
+} // namespace mi
+
+#endif /* MI_BINARY_STREAM_HPP */
@@ -0,0 +1,78 @@
+/**
+ * @file chrome_trace_sink.hpp
+ * @brief Defines the chrome_trace_sink class writing trace events
+ *        in the Chrome trace event format.
+ */
+
+#ifndef MI_CHROME_TRACE_SINK_HPP
+#define MI_CHROME_TRACE_SINK_HPP
+
+#include "trace_sink.hpp"
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+namespace mi::trace
+{
+
+/**
+ * @class chrome_trace_sink
+ * @brief A trace sink writing a JSON array of Chrome trace events.
+ *
+ * Every event is written as a duration event ("ph": "B" or "E") with the
+ * process identifier, the thread numbered in order of its first event
+ * and the library path as an argument.
+ * Timestamps are microseconds since the sink was created. The output can be
+ * opened in chrome://tracing or in the Perfetto UI.
+ *
+ * The array is closed when the sink is destroyed. Both viewers also accept
+ * the output of a process that terminated before that.
+ */
+class chrome_trace_sink final : public trace_sink
+{
+public:
+    /**
+     * @brief Writes the beginning of an operation.
+     * @param event The event to write.
+     */
+    void
+    begin(const trace_event &event) override;
+
+    /**
+     * @brief Writes the end of an operation.
+     * @param event The event to write.
+     */
+    void
+    end(const trace_event &event) override;
+
+    /**
+     * @brief Starts the trace on a stream.
+     * @param stream The stream to write to, it must outlive the sink.
+     */
+    explicit chrome_trace_sink(std::ostream &stream);
+
+    /**
+     * @brief Closes the trace and flushes the stream.
+     */
+    ~chrome_trace_sink() override;
+
+private:
+    /**
+     * @brief Writes a single event.
+     *
+     * @param phase The phase of the event, "B" or "E".
+     * @param event The event to write.
+     */
+    void
+    write(std::string_view phase, const trace_event &event);
+
+    std::ostream                         &m_stream; ///< The output of the trace.
+    std::mutex                            m_mutex;  ///< Serializes the writers.
+    std::chrono::steady_clock::time_point m_origin; ///< Time zero of the trace.
+    std::unordered_map<std::thread::id, std::size_t> m_threads; ///< Numbered threads.
+    bool                                  m_empty = true; ///< Nothing written yet.
+};
+
+} // namespace mi::trace
+
+#endif /* MI_CHROME_TRACE_SINK_HPP */
@@ -0,0 +1,328 @@
+/**
+ * @file dispatch_table.hpp
+ * @brief Defines the dispatch_table class which calls a hook on every loaded
+ *        module of a dynamic_loader.
+ *
+ * A table is created once per hook and called for every event:
+ *
+ * @code
+ * mi::dispatch_table<void(int)> ticks(loader, "on_tick");
+ * ticks(42);
+ * @endcode
+ *
+ * The hook is resolved from the modules only when the generation of the loader
+ * changed, every other call is a loop over a flat array of function pointers.
+ * Hooks too slow to be called one after another are fanned out to an executor
+ * with broadcast().
+ */
+
+#ifndef MI_DISPATCH_TABLE_HPP
+#define MI_DISPATCH_TABLE_HPP
+
+#include "dynamic_loader.hpp"
+#include "exception.hpp"
+#include "executor.hpp"
+#include "memory_account.hpp"
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include "symbol_cache.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace mi
+{
+
+/**
+ * @enum broadcast_order
+ * @brief Enumerates the orders in which the outcomes of a broadcast are reported.
+ *
+ * @var broadcast_order::BROADCAST_ORDER_COMPLETION
+ *      Every outcome is reported as soon as its hook returns.
+ *
+ * @var broadcast_order::BROADCAST_ORDER_ENTRIES
+ *      Outcomes are reported in the order of the entries of the table,
+ *      an outcome is held back until the outcomes before it are reported.
+ */
+enum broadcast_order : unsigned char
+{
+    BROADCAST_ORDER_COMPLETION = 0, /**< As the hooks return. */
+    BROADCAST_ORDER_ENTRIES    = 1  /**< In the order of the entries. */
+};
+
+template <typename FunctionType>
+class dispatch_table;
+
+/**
+ * @class dispatch_table
+ * @brief The function pointers of a hook exported by the loaded modules.
+ *
+ * Modules not exporting the hook are left out, pending modules are left out
+ * as well rather than loaded. Entries follow the attach order of the modules.
+ *
+ * A table is used by one thread at a time. Like the bindings of an
+ * interface_table, its function pointers are not pinned: modules must not be
+ * unloaded or reloaded by other threads while the table is called.
+ *
+ * @tparam ReturnType The return type of the hook.
+ * @tparam Args The parameter types of the hook.
+ */
+template <typename ReturnType, typename... Args>
+class dispatch_table<ReturnType(Args...)> final : private mixin::noncopyable,
+                                                  private mixin::nonmovable
+{
+public:
+    /**
+     * @typedef function_t
+     * @brief The signature of the hook.
+     */
+    using function_t = ReturnType(Args...);
+
+    /**
+     * @struct entry
+     * @brief A module exporting the hook.
+     */
+    struct entry
+    {
+        function_t     *function; ///< The resolved hook.
+        dynamic_module *module;   ///< The module exporting it.
+    };
+
+    /**
+     * @typedef value_t
+     * @brief The result of a hook, std::monostate for hooks returning void.
+     */
+    using value_t =
+        std::conditional_t<std::is_void_v<ReturnType>, std::monostate, ReturnType>;
+
+    /**
+     * @struct outcome
+     * @brief The outcome of a hook called by broadcast().
+     */
+    struct outcome
+    {
+        dynamic_module        *module = nullptr; ///< The module.
+        std::optional<value_t> value;            ///< The result, unless the hook threw.
+        std::exception_ptr     error;            ///< The exception thrown by the hook.
+    };
+
+    /**
+     * @typedef completion_t
+     * @brief Receives the outcomes of a broadcast while it runs.
+     */
+    using completion_t = std::function<void(const outcome &)>;
+
+    /**
+     * @brief Rebuilds the table if the modules of the loader changed.
+     * @return `true` if the table was rebuilt, `false` if it was up to date.
+     */
+    bool
+    refresh()
+    {
+        const auto generation = m_loader->generation();
+        if (generation == m_generation)
+        {
+            return false;
+        }
+
+        m_entries.clear();
+        const auto view = m_loader->view();
+        for (auto *module : view)
+        {
+            if (module->is_loaded())
+            {
+                if (auto address = module->try_sym(m_symbol))
+                {
+                    m_entries.push_back({(function_t *)*address, module});
+                }
+            }
+        }
+        m_generation = generation;
+        return true;
+    }
+
+    /**
+     * @brief Returns the modules exporting the hook, as of the last refresh().
+     * @return A constant reference to the entries.
+     */
+    [[nodiscard]]
+    const std::vector<entry> &
+    entries() const noexcept
+    {
+        return m_entries;
+    }
+
+    /**
+     * @brief Calls the hook on every module exporting it.
+     *
+     * The table is refreshed first, which costs a single atomic load
+     * unless the modules changed. Results are discarded. Allocations of
+     * every call are attributed to the memory account of its module.
+     *
+     * @param args Arguments passed to every call, they are not forwarded
+     *             so that every module receives the same values.
+     */
+    template <typename... CallArgs>
+    void
+    operator()(CallArgs &&...args)
+    {
+        refresh();
+        for (const auto &entry : m_entries)
+        {
+            memory_scope memory(entry.module->accounting());
+            entry.function(args...);
+        }
+    }
+
+    /**
+     * @brief Calls the hook on every module exporting it, concurrently.
+     *
+     * The table is refreshed first. Every call is submitted to the executor
+     * as a task, with the affinity of its module as a hint if it has one.
+     * A hook throwing an exception fails its own outcome only, the other
+     * hooks run regardless. The calling thread blocks until every hook
+     * returned, it must not be a thread the executor depends on to run them.
+     *
+     * @param executor The executor running the hooks.
+     * @param order The order in which outcomes are passed to the completion.
+     * @param completion Receives every outcome once, may be empty. Calls are
+     *                   serialized but made on the threads of the executor,
+     *                   exceptions thrown by the completion are ignored.
+     *
+     * @param args Arguments passed to every call, they are not forwarded
+     *             so that every module receives the same values.
+     *
+     * @return The outcome of every entry, in the order of the entries.
+     */
+    template <typename... CallArgs>
+    std::vector<outcome>
+    broadcast(executor           &executor,
+              broadcast_order     order,
+              const completion_t &completion,
+              CallArgs &&...args)
+    {
+        refresh();
+
+        std::vector<outcome>    outcomes(m_entries.size());
+        std::vector<bool>       finished(m_entries.size());
+        std::size_t             remaining = m_entries.size();
+        std::size_t             reported  = 0;
+        std::mutex              mutex;
+        std::condition_variable done;
+
+        auto report = [&](std::size_t index)
+        {
+            std::lock_guard lock(mutex);
+            finished[index] = true;
+            if (completion && order == BROADCAST_ORDER_COMPLETION)
+            {
+                exception::invoke_noexcept(completion, outcomes[index]);
+            }
+            else if (completion)
+            {
+                for (; reported < outcomes.size() && finished[reported]; ++reported)
+                {
+                    exception::invoke_noexcept(completion, outcomes[reported]);
+                }
+            }
+
+            /// Notified under the lock, the caller may return right after.
+            if (--remaining == 0)
+            {
+                done.notify_all();
+            }
+        };
+
+        std::size_t submitted = 0;
+        try
+        {
+            for (; submitted < m_entries.size(); ++submitted)
+            {
+                const auto &entry          = m_entries[submitted];
+                outcomes[submitted].module = entry.module;
+
+                auto task = [&, index = submitted]()
+                {
+                    auto &result = outcomes[index];
+                    try
+                    {
+                        memory_scope memory(m_entries[index].module->accounting());
+                        if constexpr (std::is_void_v<ReturnType>)
+                        {
+                            m_entries[index].function(args...);
+                            result.value.emplace();
+                        }
+                        else
+                        {
+                            result.value.emplace(m_entries[index].function(args...));
+                        }
+                    }
+                    catch (...)
+                    {
+                        result.error = std::current_exception();
+                    }
+                    report(index);
+                };
+
+                if (const auto affinity = entry.module->affinity())
+                {
+                    executor.submit_affine(std::move(task), *affinity);
+                }
+                else
+                {
+                    executor.submit(std::move(task));
+                }
+            }
+        }
+        catch (...)
+        {
+            /// The submitted tasks refer to this frame.
+            std::unique_lock lock(mutex);
+            remaining -= m_entries.size() - submitted;
+            done.wait(lock,
+                      [&remaining]()
+                      {
+                          return remaining == 0;
+                      });
+            throw;
+        }
+
+        std::unique_lock lock(mutex);
+        done.wait(lock,
+                  [&remaining]()
+                  {
+                      return remaining == 0;
+                  });
+        return outcomes;
+    }
+
+    /**
+     * @brief Constructs a table for a hook, resolved on the first call.
+     *
+     * @param loader The loader of the modules, it must outlive the table.
+     * @param hook The name of the hook,
+     *             the referenced characters must outlive the table.
+     */
+    dispatch_table(const dynamic_loader &loader, std::string_view hook) noexcept
+        : m_loader(&loader),
+          m_symbol(hook)
+    {
+    }
+
+private:
+    const dynamic_loader *m_loader;         ///< The loader of the modules.
+    dl::symbol            m_symbol;         ///< The hook with its precomputed hash.
+    std::uint64_t         m_generation = 0; ///< The generation the table was built at.
+    std::vector<entry>    m_entries;        ///< The modules exporting the hook.
+};
+
+} // namespace mi
+
+#endif /* MI_DISPATCH_TABLE_HPP */
@@ -12,13 +12,29 @@
 #include "dynamic_library_error.hpp"
 #include "exception.hpp"
 #include "fs.hpp"
+#include "interface_table.hpp"
+#include "load_policy_flags.hpp"
 #include "noncopyable.hpp"
 #include "nonmovable.hpp"
 #include "os.hpp"
+#include "result.hpp"
+#include "symbol_cache.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
 
 namespace mi::dl
 {
 
+/**
+ * @struct shared_handle
+ * @brief A handle shared by the libraries opened with LOAD_POLICY_SHARED_FLAG.
+ */
+struct shared_handle;
+
 /**
  * @class dynamic_library
  * @brief A class for loading dynamic libraries and resolving symbols.
@@ -40,6 +56,196 @@ public:
         return m_path;
     }
 
+    /**
+     * @brief Get the image the library is loaded from.
+     * @return The bytes of an in-memory library, empty for a library loaded from its path.
+     */
+    [[nodiscard]]
+    std::span<const std::byte>
+    image() const noexcept
+    {
+        return m_image;
+    }
+
+    /**
+     * @brief Get the platform handle of the dynamic library.
+     * @return The handle, or nullptr if the library is not loaded.
+     */
+    [[nodiscard]]
+    os::dynamic_library_handle_t
+    native_handle() const noexcept
+    {
+        return m_handle.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Check if the library is validated before it is opened.
+     * @return `true` if pre-flight validation is enabled, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    preflight() const noexcept
+    {
+        return m_preflight;
+    }
+
+    /**
+     * @brief Enables or disables validation of the library before it is opened.
+     *
+     * When enabled, load() inspects the file with dl::preflight() first,
+     * so a broken library is rejected before any of its code runs.
+     *
+     * @param enabled Whether to validate the library.
+     */
+    void
+    preflight(bool enabled) noexcept
+    {
+        m_preflight = enabled;
+    }
+
+    /**
+     * @brief Get the policy used to open the library.
+     * @return The load policy flags.
+     */
+    [[nodiscard]]
+    load_policy_flags
+    policy() const noexcept
+    {
+        return m_policy;
+    }
+
+    /**
+     * @brief Sets the policy used to open the library.
+     *
+     * The policy takes effect the next time the library is loaded.
+     *
+     * @param policy The load policy flags.
+     */
+    void
+    policy(load_policy_flags policy) noexcept
+    {
+        m_policy = policy;
+    }
+
+    /**
+     * @brief Check if the handle of the library is shared with other libraries.
+     * @return `true` if the library is loaded through a shared handle, `false` otherwise.
+     *
+     * @see LOAD_POLICY_SHARED_FLAG
+     */
+    [[nodiscard]]
+    bool
+    is_shared() const noexcept
+    {
+        return m_shared != nullptr;
+    }
+
+    /**
+     * @brief Get the time the platform loader took to open the library.
+     *
+     * The duration covers mapping, relocation, binding and static
+     * initialization of the library and of its dependencies, i.e. with
+     * LOAD_POLICY_NOW_FLAG it includes the binding otherwise deferred
+     * to the first calls. The open is traced as "dlopen" as well.
+     *
+     * @return The duration of the last successful open, zero if never loaded
+     *         or if the library joined a shared handle.
+     */
+    [[nodiscard]]
+    std::chrono::nanoseconds
+    load_duration() const noexcept
+    {
+        return m_load_duration;
+    }
+
+    /**
+     * @brief Check if the library is loaded on first use.
+     * @return `true` if loading is deferred by a dynamic_loader, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    on_demand() const noexcept
+    {
+        return m_on_demand;
+    }
+
+    /**
+     * @brief Sets whether the library is loaded on first use.
+     *
+     * When enabled, a dynamic_loader does not load the library together with
+     * the other modules but defers it with defer(), so that a library which is
+     * never used is never mapped.
+     *
+     * @param enabled Whether to load the library on first use.
+     */
+    void
+    on_demand(bool enabled) noexcept
+    {
+        m_on_demand = enabled;
+    }
+
+    /**
+     * @brief Check if the library is waiting for its first use to be loaded.
+     * @return `true` if the library is deferred and not loaded yet, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    is_pending() const noexcept
+    {
+        return m_pending.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Defers loading the library until it is first used.
+     *
+     * The library is loaded by the first sym() or call(), or by activate().
+     * Concurrent first users are serialized, the library is loaded once
+     * and all of them proceed once load() returned.
+     *
+     * Deferring a loaded library has no effect.
+     */
+    void
+    defer() noexcept
+    {
+        if (is_unloaded())
+        {
+            m_pending.store(true, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Loads a pending library now.
+     *
+     * Does nothing if the library is not pending. If loading fails, the library
+     * is not pending anymore and the error is rethrown, later uses report
+     * the library as not loaded.
+     *
+     * @throw dynamic_library_error If the library cannot be loaded.
+     */
+    void
+    activate() const
+    {
+        try_activate().value();
+    }
+
+    /**
+     * @brief Loads a pending library now without throwing its load errors.
+     *
+     * @return Nothing, or the error the library failed to load with.
+     *
+     * @see activate()
+     */
+    [[nodiscard]]
+    result<void>
+    try_activate() const
+    {
+        if (is_pending())
+        {
+            return load_pending();
+        }
+        return {};
+    }
+
     /**
      * @brief Check if the library is unloaded.
      * @return `true` if the library is unloaded, `false` otherwise.
@@ -97,6 +303,65 @@ public:
     virtual os::dynamic_library_func_t
     sym_unsafe(std::string_view name) const;
 
+    /**
+     * @brief Retrieves a symbol from the dynamic library.
+     *
+     * Resolved addresses are kept in a per-library cache,
+     * so only the first lookup of a symbol reaches the platform loader.
+     * The cache is cleared when the library is unloaded.
+     *
+     * @param symbol The symbol to retrieve, with its precomputed hash.
+     * @return A function pointer to the symbol.
+     *
+     * @throw dynamic_library_error If the library is not loaded.
+     */
+    [[nodiscard]]
+    os::dynamic_library_func_t
+    sym(const symbol &symbol) const
+    {
+        activate();
+        auto guard = pin();
+        return lookup(symbol).value();
+    }
+
+    /**
+     * @brief Retrieves a symbol from the dynamic library without throwing.
+     *
+     * @param symbol The symbol to retrieve, with its precomputed hash.
+     * @return A function pointer to the symbol, or the error if the library
+     *         is not loaded, fails to load on first use or does not export it.
+     */
+    [[nodiscard]]
+    result<os::dynamic_library_func_t>
+    try_sym(const symbol &symbol) const
+    {
+        if (auto activated = try_activate(); !activated)
+        {
+            return activated.error();
+        }
+
+        auto guard   = pin();
+        auto address = lookup(symbol);
+        if (address.has_value() && *address == nullptr)
+        {
+            return error(errc::symbol_not_found, m_path, std::string(symbol.name()));
+        }
+        return address;
+    }
+
+    /**
+     * @brief Retrieves a symbol from the dynamic library without throwing.
+     *
+     * @param name The name of the symbol to retrieve.
+     * @return A function pointer to the symbol, or the error.
+     */
+    [[nodiscard]]
+    result<os::dynamic_library_func_t>
+    try_sym(std::string_view name) const
+    {
+        return try_sym(symbol(name));
+    }
+
     /**
      * @brief Retrieves a symbol from the dynamic library.
      *
@@ -107,7 +372,10 @@ public:
      */
     [[nodiscard]]
     os::dynamic_library_func_t
-    sym(std::string_view name) const;
+    sym(std::string_view name) const
+    {
+        return sym(symbol(name));
+    }
 
     /**
      * @brief Template method to resolve a symbol to a specific function type.
@@ -121,7 +389,22 @@ public:
     FunctionType *
     sym(std::string_view name) const
     {
-        return (FunctionType *)sym(name.data());
+        return (FunctionType *)sym(symbol(name));
+    }
+
+    /**
+     * @brief Template method to resolve a symbol to a specific function type.
+     *
+     * @param symbol The symbol to resolve, with its precomputed hash.
+     * @return Pointer to the resolved function cast to the specified type.
+     *
+     * @throw dynamic_library_error If the library is not loaded.
+     */
+    template <typename FunctionType>
+    FunctionType *
+    sym(const symbol &symbol) const
+    {
+        return (FunctionType *)sym(symbol);
     }
 
     /**
@@ -138,33 +421,232 @@ public:
     std::invoke_result_t<FunctionType, Args...>
     call(std::string_view name, Args &&...args) const
     {
-        if (auto func = sym<FunctionType>(name))
+        return call<FunctionType>(symbol(name), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Calls a function from the dynamic library by symbol.
+     *
+     * The library is pinned for the duration of the call,
+     * so a concurrent reload() waits for the call to return.
+     *
+     * @param symbol The symbol of the function to call, with its precomputed hash.
+     * @param args Arguments to be passed to the function.
+     * @return The result of invoking the function.
+     *
+     * @throw dynamic_library_error If the library is not loaded.
+     * @throw dynamic_library_error If the function is not found.
+     */
+    template <typename FunctionType, typename... Args>
+    std::invoke_result_t<FunctionType, Args...>
+    call(const symbol &symbol, Args &&...args) const
+    {
+        return try_call<FunctionType>(symbol, std::forward<Args>(args)...).value();
+    }
+
+    /**
+     * @brief Calls a function from the dynamic library by name without throwing.
+     *
+     * @param name The name of the function to call.
+     * @param args Arguments to be passed to the function.
+     * @return The result of invoking the function, or the error.
+     */
+    template <typename FunctionType, typename... Args>
+    result<std::invoke_result_t<FunctionType, Args...>>
+    try_call(std::string_view name, Args &&...args) const
+    {
+        return try_call<FunctionType>(symbol(name), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Calls a function from the dynamic library by symbol without throwing.
+     *
+     * The library is pinned for the duration of the call like with call().
+     * Only the failures of the library are reported as errors, exceptions
+     * thrown by the function itself propagate.
+     *
+     * @param symbol The symbol of the function to call, with its precomputed hash.
+     * @param args Arguments to be passed to the function.
+     * @return The result of invoking the function, or the error if the library
+     *         is not loaded, fails to load on first use or does not export it.
+     */
+    template <typename FunctionType, typename... Args>
+    result<std::invoke_result_t<FunctionType, Args...>>
+    try_call(const symbol &symbol, Args &&...args) const
+    {
+        if (auto activated = try_activate(); !activated)
+        {
+            return activated.error();
+        }
+
+        auto guard   = pin();
+        auto address = lookup(symbol);
+        if (!address)
+        {
+            return address.error();
+        }
+        else if (*address == nullptr)
+        {
+            return error(errc::symbol_not_found, m_path, std::string(symbol.name()));
+        }
+
+        auto *func = (FunctionType *)*address;
+        if constexpr (std::is_void_v<std::invoke_result_t<FunctionType, Args...>>)
+        {
+            std::invoke(*func, std::forward<Args>(args)...);
+            return {};
+        }
+        else
         {
             return std::invoke(*func, std::forward<Args>(args)...);
         }
-        throw exception::dynamic_library_error("no function from dynamic library "
-                                               "(function: {}, path: {})",
-                                               name,
-                                               m_path);
+    }
+
+    /**
+     * @class pin_guard
+     * @brief Keeps the current version of a library in place while it exists.
+     *
+     * A pin counts the caller as a reader of the library, which reload()
+     * waits to drop to zero before it swaps the library. Pinning takes no
+     * lock: it costs an atomic increment and a load, unless a swap is in
+     * progress, in which case the first pin of the thread waits for it.
+     *
+     * The pins of a thread are linked together, so a pin nested in another
+     * pin of the same library never waits, the swap is held back by the
+     * outer one anyway.
+     */
+    class pin_guard : private mixin::noncopyable, private mixin::nonmovable
+    {
+    public:
+        /**
+         * @brief Pins a library.
+         * @param library The library, or nullptr for a pin doing nothing.
+         */
+        explicit pin_guard(const dynamic_library *library) noexcept;
+
+        /**
+         * @brief Unpins the library.
+         */
+        ~pin_guard() override;
+
+    private:
+        const dynamic_library *m_library;        ///< The pinned library.
+        pin_guard             *m_next = nullptr; ///< The previous pin of the thread.
+
+        static inline thread_local pin_guard *t_pins = nullptr; ///< The last pin.
+    };
+
+    /**
+     * @brief Keeps the current version of the library in place.
+     *
+     * While the returned guard exists, reload() cannot swap the library,
+     * so addresses obtained from sym() or from bound interface tables
+     * stay valid. call() pins the library on its own.
+     *
+     * Pins may be nested on the same thread. Pins taken by the hooks run
+     * during reload() on the reloading thread are no-ops.
+     *
+     * @return The guard pinning the library.
+     */
+    [[nodiscard]]
+    pin_guard
+    pin() const noexcept
+    {
+        if (m_swapper.load(std::memory_order_relaxed) == std::this_thread::get_id())
+        {
+            return pin_guard(nullptr);
+        }
+        return pin_guard(this);
+    }
+
+    /**
+     * @brief Attaches an interface table to the library.
+     *
+     * The bindings of the table are resolved in one pass every time the
+     * library is loaded and reset when it is unloaded. If the library is
+     * already loaded, the table is resolved immediately.
+     *
+     * A missing required symbol fails the load, so the bindings can be called
+     * without further checks while the library is loaded.
+     *
+     * @param table The table to resolve, it must stay alive
+     *              until it is unbound or the library is destroyed.
+     *
+     * @throw dynamic_library_error If the library is loaded
+     *                              and a required symbol is missing.
+     */
+    void
+    bind(interface_table &table);
+
+    /**
+     * @brief Detaches an interface table from the library and resets it.
+     * @param table The table to detach.
+     */
+    void
+    unbind(interface_table &table) noexcept;
+
+    /**
+     * @brief Returns the counters of the symbol cache.
+     * @return The number of cached and uncached symbol lookups.
+     */
+    [[nodiscard]]
+    symbol_cache_stats
+    symbol_stats() const noexcept
+    {
+        return m_cache->stats();
     }
 
     /**
      * @brief Loads the dynamic library into memory.
      *
      * Attempts to load the dynamic library file specified by the path set in
-     * the dynamic_library instance. It checks for readability of the file,
-     * correct file extension, and whether the library is already loaded.
+     * the dynamic_library instance. It checks for correct file extension,
+     * whether the library is already loaded and readability of the file.
      * If any of these checks fail, a dynamic_library_error is thrown.
      *
-     * @throws dynamic_library_error if the file is not readable,
-     *                               has an invalid extension, or is already loaded.
+     * On Linux the file is opened once and checked on its descriptor with a
+     * single statx: it must be a non-empty regular file. With
+     * LOAD_POLICY_DESCRIPTOR_FLAG the library is then opened through that
+     * descriptor rather than by path.
+     *
+     * If pre-flight validation is enabled, the file is inspected first and
+     * must export every symbol returned by required_symbols().
+     *
+     * Once the library is open, all bound interface tables are resolved.
+     * If a required symbol is missing, the library is closed again.
+     *
+     * @throws dynamic_library_error if the file is not readable, not a regular
+     *                               file or empty,
+     *                               has an invalid extension, is already loaded,
+     *                               fails pre-flight validation,
+     *                               or does not export a required symbol.
      *
      * @note This method is platform-dependent and uses different APIs
      *       to load the library on UNIX-like systems and Windows.
+     *
+     * @see try_load()
      */
     virtual void
     load();
 
+    /**
+     * @brief Loads the dynamic library into memory without throwing.
+     *
+     * Performs the checks and the open of load() and reports the first
+     * failure as an error, formatting nothing. Pre-flight validation reports
+     * its failures the same way, so probing many candidates that mostly fail
+     * costs no exceptions. load() is a wrapper throwing the error.
+     *
+     * Derived classes extend this function rather than load().
+     *
+     * @return Nothing, or the error the library failed to load with,
+     *         errc::close_failed if it cannot be closed again
+     *         after a required symbol is missing.
+     */
+    [[nodiscard]]
+    virtual result<void>
+    try_load();
+
     /**
      * @brief Unloads the dynamic library from memory.
      *
@@ -174,6 +656,8 @@ public:
      * If the library is loaded, it uses platform-specific API to unload it.
      * If the unloading process fails, a dynamic_library_error is thrown.
      *
+     * A pending library is not pending anymore, it is not loaded just to be unloaded.
+     *
      * @throws dynamic_library_error if the library could not be unloaded.
      * @note This method is platform-dependent and uses dlclose on UNIX-like systems
      *       and FreeLibrary on Windows to unload the dynamic library.
@@ -181,12 +665,63 @@ public:
     virtual void
     unload();
 
+    /**
+     * @brief Replaces the loaded library with the current contents of its file.
+     *
+     * The new version is opened next to the loaded one, under a name
+     * of its own, so that the platform loader does not return the loaded
+     * version again. Bound interface tables are checked against it before
+     * anything changes; if a required symbol is missing, the new version is
+     * closed and the loaded one is kept.
+     *
+     * The swap then waits for in-flight calls to return and holds new calls
+     * back while the symbol cache is cleared and the tables are resolved
+     * again. The previous version is closed once the swap is complete.
+     *
+     * @throw dynamic_library_error If the library is not loaded, is loaded
+     *                              from memory or through a shared handle, the
+     *                              file is the loaded version, the new version
+     *                              fails to open or pre-flight validation,
+     *                              or does not export a required symbol.
+     *
+     * @warning The file must be replaced by a rename rather than rewritten in
+     *          place: the loaded version is mapped from it, and the platform
+     *          loader recognizes the same file as the same library. A file
+     *          rewritten in place fails to reload as the loaded version.
+     *
+     * @warning Objects holding addresses or tables of the previous version,
+     *          such as a gnu_hash_resolver, have to be recreated.
+     *
+     * @note Hot reload is supported on Linux only,
+     *       elsewhere the function throws.
+     */
+    virtual void
+    reload();
+
     /**
      * @brief Construct a new dynamic library object.
      * @param path The filesystem path to the dynamic library.
      */
     explicit dynamic_library(fs::path_t path);
 
+    /**
+     * @brief Construct a dynamic library loaded from memory.
+     *
+     * load() copies the image into an anonymous memory file, seals it and
+     * opens the library from there, so nothing is written to disk and nothing
+     * has to be cleaned up. The image may be a range of a mapped archive.
+     *
+     * @param path The name of the library, used in errors and to resolve
+     *             $ORIGIN during pre-flight validation. No file has to exist.
+     *
+     * @param image The contents of the library, they must stay valid
+     *              as long as the library may be loaded.
+     *
+     * @note In-memory libraries are supported on Linux only,
+     *       elsewhere load() throws. They cannot be reloaded.
+     */
+    dynamic_library(fs::path_t path, std::span<const std::byte> image);
+
     /**
      * @brief Destroy the dynamic library object.
      *        Unloads the dynamic library if it is loaded.
@@ -195,9 +730,145 @@ public:
      */
     ~dynamic_library() override;
 
+protected:
+    /**
+     * @brief Returns the symbols checked by pre-flight validation.
+     * @return The names of the symbols the library must export, none by default.
+     */
+    [[nodiscard]]
+    virtual std::span<const std::string_view>
+    required_symbols() const noexcept
+    {
+        return {};
+    }
+
+    /**
+     * @brief Called by reload() before the new version replaces the current one.
+     *
+     * In-flight calls have returned and new calls are held back while the hook
+     * runs, calls made by the hook itself still reach the current version.
+     *
+     * @param current The handle of the loaded version.
+     * @param next The handle of the new version.
+     */
+    virtual void
+    before_reload(os::dynamic_library_handle_t current,
+                  os::dynamic_library_handle_t next);
+
+    /**
+     * @brief Called by reload() once the new version replaced the previous one.
+     *
+     * New calls are still held back while the hook runs, calls made by the
+     * hook itself reach the new version. The previous version stays open
+     * until the hook returns.
+     *
+     * @param previous The handle of the replaced version.
+     */
+    virtual void
+    after_reload(os::dynamic_library_handle_t previous);
+
+    /**
+     * @brief Retrieves a symbol from a specific version of the library.
+     *
+     * @param handle The handle of the opened library.
+     * @param name The name of the symbol.
+     * @return The address of the symbol, or nullptr if it is not exported.
+     */
+    [[nodiscard]]
+    static os::dynamic_library_func_t
+    sym_unsafe(os::dynamic_library_handle_t handle, std::string_view name) noexcept;
+
 private:
-    fs::path_t                   m_path;
-    os::dynamic_library_handle_t m_handle;
+    /**
+     * @brief Retrieves a symbol through the cache without pinning the library.
+     *
+     * @param symbol The symbol to retrieve, with its precomputed hash.
+     * @return A function pointer to the symbol, nullptr if it is not exported,
+     *         or the error if the library is not loaded.
+     */
+    [[nodiscard]]
+    result<os::dynamic_library_func_t>
+    lookup(const symbol &symbol) const;
+
+    /**
+     * @brief Loads the library on behalf of its first user.
+     *
+     * The first user loads the library while the others wait for it,
+     * users entering again from the load on the same thread return at once.
+     *
+     * @return Nothing, or the error the library failed to load with.
+     */
+    result<void>
+    load_pending() const;
+
+    /**
+     * @brief Resolves all bound tables, the library is closed again if one
+     *        misses a required symbol.
+     *
+     * @return Nothing, the error naming the missing symbols,
+     *         or the error the library failed to be closed with.
+     */
+    result<void>
+    resolve_tables();
+
+    /**
+     * @brief Joins the shared handle registered for a file or an image.
+     *
+     * @param key The key of the file or the image in the registry.
+     * @return `true` if the library is loaded through the shared handle,
+     *         `false` if none is registered.
+     */
+    bool
+    join_shared(const std::string &key);
+
+    /**
+     * @brief Registers the handle of the newly opened library for sharing.
+     *
+     * @param key The key of the file or the image in the registry.
+     * @param descriptor The descriptor the library was opened through,
+     *                   owned by the shared handle from now on, or -1.
+     */
+    void
+    publish_shared(const std::string &key, int descriptor);
+
+    /**
+     * @brief Drops the reference to the shared handle,
+     *        the last reference closes the library.
+     *
+     * @return `true` on success, `false` if the library failed to close.
+     */
+    bool
+    release_shared() noexcept;
+
+    /**
+     * @brief Resolves the bindings of a table from the loaded library.
+     *
+     * @param table The table to resolve.
+     * @return The comma-separated names of missing required symbols,
+     *         empty if the table is fully bound.
+     */
+    std::string
+    resolve(interface_table &table) const;
+
+    fs::path_t                                m_path;
+    std::span<const std::byte>                m_image;     ///< Contents of an in-memory library.
+    std::atomic<os::dynamic_library_handle_t> m_handle;
+    mutable symbol_cache                      m_symbols;   ///< Resolved symbol addresses.
+    symbol_cache                  *m_cache = &m_symbols; ///< Own or shared cache.
+    std::shared_ptr<shared_handle> m_shared; ///< Shared with identical libraries.
+    std::vector<interface_table *>            m_tables;    ///< Tables resolved on load.
+    bool                                      m_preflight = false; ///< Validate first.
+    load_policy_flags m_policy = LOAD_POLICY_NONE_FLAGS; ///< Options of the open.
+    std::chrono::nanoseconds         m_load_duration{};    ///< Last open time.
+    int                              m_descriptor = -1;    ///< File of a reloaded version.
+    mutable std::atomic<std::size_t> m_readers{0};         ///< Pins of the library.
+    mutable std::atomic<bool>        m_swapping{false};    ///< Pins wait for the swap.
+    std::mutex                       m_swap;               ///< Serializes reload().
+    std::atomic<std::thread::id>     m_swapper;            ///< The thread running reload().
+    bool                             m_on_demand = false;  ///< Deferred by loaders.
+    mutable std::atomic<bool>        m_pending{false};     ///< Waiting for first use.
+    mutable std::recursive_mutex     m_activation;         ///< Serializes first users.
+    mutable bool                     m_activating = false; ///< Set during the load.
 };
 
 /**
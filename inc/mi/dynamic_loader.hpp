@@ -8,6 +8,15 @@
 
 #include "base_loader.hpp"
 #include "dynamic_module.hpp"
+#include "load_mode.hpp"
+#include "module_bundle.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mi
 {
@@ -29,6 +38,8 @@ namespace mi
  * It is designed to work with any module class that fulfills the requirements
  * of being a dynamic module, making it versatile and adaptable
  * to different use cases.
+ *
+ * Attached modules are indexed by their name, see find_module().
  */
 class dynamic_loader : public dynamic_module, public base_loader<dynamic_module>
 {
@@ -36,8 +47,14 @@ protected:
     /**
      * @brief Loads all modules that are currently unloaded.
      *
-     * This function iterates over each module in reverse order
-     * and attempts to load it, if it is not already loaded.
+     * Modules are loaded in dependency order, so that every module is loaded
+     * after the modules it depends on. Depending on the load mode, modules are
+     * either loaded one by one or independent modules are loaded concurrently.
+     *
+     * Modules loaded on demand are deferred instead,
+     * each of them is loaded by its first use.
+     *
+     * @throw dynamic_loader_error If the module dependencies form a cycle.
      */
     virtual void
     load_modules();
@@ -45,18 +62,85 @@ protected:
     /**
      * @brief Unloads all modules that are currently loaded.
      *
-     * This function iterates over each module in reverse order
-     * and attempts to unload it, if it is not already unloaded.
+     * Modules are unloaded in reverse dependency order, so that every module
+     * is unloaded before the modules it depends on. Pending modules are
+     * not pending anymore, they are not loaded. Depending on the load mode,
+     * modules are either unloaded one by one or independent modules are
+     * unloaded concurrently.
+     *
+     * @throw dynamic_loader_error If the module dependencies form a cycle.
      */
     virtual void
     unload_modules();
 
+    /**
+     * @brief Applies an action to the attached modules in dependency order.
+     *
+     * In sequential mode the action is applied on the calling thread.
+     * In parallel mode it is applied on a pool of worker threads, every module
+     * is processed once all modules preceding it in the graph are processed.
+     *
+     * If the action throws, no further modules are scheduled,
+     * and the first exception is rethrown once the running actions finish.
+     *
+     * @param reverse If `true`, dependents are processed before their
+     *                dependencies, otherwise dependencies are processed first.
+     *
+     * @param action The action to apply to each module.
+     *
+     * @throw dynamic_loader_error If the module dependencies form a cycle.
+     */
+    void
+    traverse_modules(bool reverse, const std::function<void(dynamic_module &)> &action);
+
 public:
     /**
      * @brief Inherits the constructor of dynamic_module.
      */
     using dynamic_module::dynamic_module;
 
+    /**
+     * @brief Returns the mode used to load and unload attached modules.
+     * @return The current load mode.
+     */
+    [[nodiscard]]
+    load_mode
+    mode() const noexcept
+    {
+        return m_mode;
+    }
+
+    /**
+     * @brief Sets the mode used to load and unload attached modules.
+     * @param mode The new load mode.
+     */
+    void
+    mode(load_mode mode) noexcept
+    {
+        m_mode = mode;
+    }
+
+    /**
+     * @brief Returns the number of worker threads used in parallel mode.
+     * @return The number of workers, zero stands for the hardware concurrency.
+     */
+    [[nodiscard]]
+    std::size_t
+    workers() const noexcept
+    {
+        return m_workers;
+    }
+
+    /**
+     * @brief Sets the number of worker threads used in parallel mode.
+     * @param workers The number of workers, zero selects the hardware concurrency.
+     */
+    void
+    workers(std::size_t workers) noexcept
+    {
+        m_workers = workers;
+    }
+
     /**
      * @brief Attaches a module of type CustomType to the system.
      *
@@ -84,24 +168,214 @@ public:
      *
      * @return CustomType& A reference to the
      *         attached module of type CustomType.
+     *
+     * @note The module inherits the load policy, the pre-flight setting,
+     *       the on demand setting and the manifest of the loader, all of them
+     *       can be changed on the module afterwards.
      */
     template <typename CustomType, typename... Args>
     CustomType &
     attach_module(Args &&...args)
     {
-        return this->emplace_unique<CustomType>(*this,
-                                                logger(),
-                                                std::forward<Args>(args)...);
+        auto &module = this->emplace_unique<CustomType>(*this,
+                                                        logger(),
+                                                        std::forward<Args>(args)...);
+        module.policy(policy());
+        module.preflight(preflight());
+        module.on_demand(on_demand());
+        module.manifest(manifest());
+        return module;
+    }
+
+    /**
+     * @brief Returns the generation of the set of loaded modules.
+     *
+     * The generation changes whenever a module is attached, described, loaded,
+     * reloaded or unloaded, so state derived from the modules, such as
+     * a dispatch_table, is rebuilt only when it differs.
+     *
+     * @return The generation, never 0.
+     */
+    [[nodiscard]]
+    std::uint64_t
+    generation() const noexcept
+    {
+        return m_generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Finds an attached module by the name in its module_info.
+     *
+     * The index is updated whenever the known information of a module
+     * changes, i.e. when it is attached, described, loaded or unloaded.
+     * Loaded modules are indexed by their captured information, modules not
+     * loaded by the information known without loading them, see
+     * dynamic_module::known_info(). Modules without such information are
+     * found once they are loaded. The index is published with the snapshot
+     * of the modules, the lookup takes no lock and never loads a module.
+     *
+     * @param name The name of the module.
+     * @return The module, which stays valid as long as the loader exists,
+     *         or nullptr if no module has the name. If several modules share
+     *         the name, any one of them.
+     */
+    [[nodiscard]]
+    dynamic_module *
+    find_module(std::string_view name) const;
+
+    /**
+     * @brief Finds the candidate modules in a directory tree.
+     *
+     * The directory is enumerated recursively, symbolic links to directories
+     * are not followed and unreadable subdirectories are skipped. Regular files
+     * with the os::DYNAMIC_LIBRARY_EXTENSION extension are then validated
+     * on a pool of worker threads: a candidate has to be readable and, if
+     * pre-flight validation is enabled on this loader, pass dl::preflight()
+     * with the symbols every dynamic module exports. Candidates failing
+     * validation are left out. Candidates described by the manifest of the
+     * loader have been loaded before and are not validated again as long as
+     * their file is unchanged.
+     *
+     * @param directory The root of the directory tree to scan.
+     * @return The paths of the valid candidates in lexicographic order.
+     *
+     * @throw dynamic_loader_error If the directory cannot be enumerated.
+     */
+    [[nodiscard]]
+    std::vector<fs::path_t>
+    scan_modules(const fs::path_t &directory);
+
+    /**
+     * @brief Attaches the modules found in a directory tree.
+     *
+     * The candidates returned by scan_modules() are attached in lexicographic
+     * order of their paths, so that the attach order, which breaks ties in the
+     * load order, does not depend on the file system. Paths already attached
+     * to this loader are skipped.
+     *
+     * @tparam CustomType The type of the modules to attach.
+     *
+     * @tparam Args Variadic template arguments representing the types
+     *              of arguments to be forwarded after the path.
+     *
+     * @param directory The root of the directory tree to scan.
+     * @param args Arguments forwarded to the constructor of each module.
+     *
+     * @return The number of modules attached.
+     *
+     * @throw dynamic_loader_error If the directory cannot be enumerated.
+     */
+    template <typename CustomType = dynamic_module, typename... Args>
+    std::size_t
+    discover_modules(const fs::path_t &directory, Args &&...args)
+    {
+        std::unordered_set<fs::path_t> attached;
+        for (const auto &module : *this)
+        {
+            if (module != nullptr)
+            {
+                attached.insert(module->path());
+            }
+        }
+
+        std::size_t count = 0;
+        for (const auto &path : scan_modules(directory))
+        {
+            if (attached.insert(path).second)
+            {
+                attach_module<CustomType>(path, args...);
+                ++count;
+            }
+        }
+        return count;
     }
 
+    /**
+     * @typedef bundle_filter_t
+     * @brief Selects the members of a bundle to attach.
+     */
+    using bundle_filter_t = std::function<bool(const module_bundle_member &)>;
+
+    /**
+     * @brief Attaches the modules stored in a bundle.
+     *
+     * Every selected member is attached as an in-memory module named after
+     * the member, next to the bundle file, and described by the bundle index,
+     * so info() is answered without loading it. Nothing is read from the
+     * file system per member. Names already attached to this loader are
+     * skipped.
+     *
+     * @tparam CustomType The type of the modules to attach.
+     *
+     * @param bundle The bundle, it must outlive the attached modules.
+     * @param filter Selects the members to attach, all of them if empty.
+     *
+     * @return The number of modules attached.
+     */
+    template <typename CustomType = dynamic_module>
+    std::size_t
+    attach_bundle(const module_bundle &bundle, const bundle_filter_t &filter = nullptr)
+    {
+        std::unordered_set<fs::path_t> attached;
+        for (const auto &module : *this)
+        {
+            if (module != nullptr)
+            {
+                attached.insert(module->path());
+            }
+        }
+
+        std::size_t count = 0;
+        for (const auto &member : bundle.members())
+        {
+            auto path = bundle.path().parent_path() / member.name;
+            if ((!filter || filter(member)) && attached.insert(path).second)
+            {
+                attach_module<CustomType>(path, member.image).describe(member.description);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Loads the attached modules on an executor.
+     *
+     * Modules are handled as by load_modules(), but every module is submitted
+     * to the executor as soon as the modules it depends on are loaded, and
+     * the caller returns right away. No task blocks waiting for another one,
+     * so any executor with at least one thread makes progress.
+     *
+     * If a module fails to load, the modules depending on it are not loaded
+     * and their futures hold the same exception.
+     *
+     * @param executor The executor loading the modules,
+     *                 it must outlive the returned futures.
+     *
+     * @return The future of each attached module, so that the caller can join
+     *         on the modules it needs.
+     *
+     * @throw dynamic_loader_error If the module dependencies form a cycle,
+     *                             nothing is submitted then.
+     */
+    [[nodiscard]]
+    std::unordered_map<const dynamic_module *, std::shared_future<void>>
+    async_load_modules(executor &executor);
+
     /**
      * @brief Loads the dynamic module and then loads all unloaded modules.
      *
      * This is a higher level function that first calls the load function of the
      * dynamic_module and then proceeds to load all other modules that are unloaded.
+     *
+     * @return Nothing, the error the library of the loader failed to load
+     *         with, the modules are not loaded then, or errc::modules_failed
+     *         if a module fails to load or the module dependencies form
+     *         a cycle, the modules loaded so far stay loaded then.
      */
-    void
-    load() override;
+    [[nodiscard]]
+    dl::result<void>
+    try_load() override;
 
     /**
      * @brief Unloads all loaded modules and then the dynamic module itself.
@@ -111,6 +385,26 @@ public:
      */
     void
     unload() override;
+
+private:
+    friend class dynamic_module;
+
+    /**
+     * @brief Records a change of an attached module.
+     *
+     * Advances the generation and indexes the module by the name it is known
+     * by with base_loader::index_name(), replacing the name it was indexed by
+     * before. Called by the module itself, modules attached to other loaders
+     * are not recorded.
+     *
+     * @param module The module.
+     */
+    void
+    module_changed(dynamic_module &module) const;
+
+    load_mode   m_mode    = LOAD_MODE_SEQUENTIAL; ///< How modules are loaded.
+    std::size_t m_workers = 0; ///< Worker threads used in parallel mode.
+    mutable std::atomic<std::uint64_t> m_generation{1}; ///< Advanced on changes.
 };
 
 } // namespace mi
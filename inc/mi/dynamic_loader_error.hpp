@@ -0,0 +1,28 @@
+/**
+ * @file dynamic_loader_error.hpp
+ * @brief Defines the mi::exception::dynamic_loader_error class.
+ *
+ * This header file extends the custom exception types provided by the MI library
+ * to include an exception for errors detected by the dynamic loader itself,
+ * such as broken or cyclic module dependencies.
+ */
+
+#ifndef MI_DYNAMIC_LOADER_ERROR_HPP
+#define MI_DYNAMIC_LOADER_ERROR_HPP
+
+#include "runtime_error.hpp"
+
+namespace mi::exception
+{
+
+/**
+ * @brief Declare a new error class for dynamic loader errors.
+ * @details Utilizes the MI_DECLARE_NEW_ERROR_CLASS macro from "runtime_error.hpp"
+ *          to define a new exception class that inherits
+ *          from mi::exception::runtime_error.
+ */
+MI_DECLARE_NEW_ERROR_CLASS(dynamic_loader_error);
+
+} // namespace mi::exception
+
+#endif /* MI_DYNAMIC_LOADER_ERROR_HPP */
@@ -7,10 +7,23 @@
 #ifndef MI_DYNAMIC_MODULE_HPP
 #define MI_DYNAMIC_MODULE_HPP
 
+#include "async_operation.hpp"
 #include "dynamic_library.hpp"
+#include "dynamic_loader_error.hpp"
 #include "extension_logger.hpp"
 #include "logger_aware_class.hpp"
+#include "memory_account.hpp"
+#include "module_arena.hpp"
 #include "module_info.hpp"
+#include "module_manifest.hpp"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace mi
 {
@@ -37,10 +50,27 @@ public:
      *
      * It ensures the dynamic library
      * associated with this module is loaded appropriately.
+     *
+     * Throws the error of try_load(), which does the work.
      */
     void
     load() override;
 
+    /**
+     * @brief Loads the dynamic module without throwing the errors of the library.
+     *
+     * Pending dependencies are activated first, so that a module loaded
+     * on first use finds the modules it depends on loaded as well.
+     * Once the library is loaded, the module is described and its load
+     * hook is called.
+     *
+     * @return Nothing, or the error the library or a pending dependency
+     *         failed to load with.
+     */
+    [[nodiscard]]
+    dl::result<void>
+    try_load() override;
+
     /**
      * @brief Unloads the dynamic module.
      *
@@ -51,6 +81,52 @@ public:
     void
     unload() override;
 
+    /**
+     * @brief Returns an awaitable loading the module on an executor.
+     *
+     * The module is loaded with load() once the awaitable is awaited,
+     * the awaiting coroutine resumes on the executor afterwards.
+     *
+     * @param executor The executor running load(), it must outlive the co_await.
+     * @return The awaitable, rethrowing any exception thrown by load().
+     */
+    [[nodiscard]]
+    async_operation
+    async_load(executor &executor);
+
+    /**
+     * @brief Returns an awaitable unloading the module on an executor.
+     *
+     * @param executor The executor running unload(), it must outlive the co_await.
+     * @return The awaitable, rethrowing any exception thrown by unload().
+     */
+    [[nodiscard]]
+    async_operation
+    async_unload(executor &executor);
+
+    /**
+     * @brief Loads the module on an executor.
+     *
+     * The module is submitted right away, the caller keeps running
+     * and joins on the returned future when it needs the module.
+     *
+     * @param executor The executor running load().
+     * @return The future of the load, holding any exception thrown by load().
+     */
+    [[nodiscard]]
+    std::future<void>
+    load_future(executor &executor);
+
+    /**
+     * @brief Unloads the module on an executor.
+     *
+     * @param executor The executor running unload().
+     * @return The future of the unload, holding any exception thrown by unload().
+     */
+    [[nodiscard]]
+    std::future<void>
+    unload_future(executor &executor);
+
     /**
      * @brief Retrieves module information from the dynamic library.
      *
@@ -70,6 +146,15 @@ public:
      *       call<const module_info &()>. Hence, the existence and correct
      *       signature of on_module_info within the library are critical.
      *
+     * @note The information is captured once after the module is loaded
+     *       and served from memory until the module is unloaded.
+     *
+     * @note A pending module is loaded by the first call, unless its file is
+     *       described by the manifest or carries an MI_MODULE_INFO_NOTE.
+     *       While the module is not loaded, the information is taken from
+     *       the manifest, or else from the note read off the mapped file,
+     *       without loading it.
+     *
      * @return A constant reference to a module_info instance,
      *         representing the module's information.
      *
@@ -87,6 +172,17 @@ public:
     virtual const module_info &
     info() const;
 
+    /**
+     * @brief Returns the module information known without loading the module.
+     *
+     * @return The captured information of a loaded module, otherwise the
+     *         information recorded by the description, the manifest or the note,
+     *         or nullptr if none of them describes the module.
+     */
+    [[nodiscard]]
+    const module_info *
+    known_info() const noexcept;
+
     /**
      * @brief Returns the directory path of the loaded dynamic module.
      *
@@ -139,6 +235,14 @@ public:
      *
      * @return A string representing the class name of the instance.
      *
+     * @note The class name is composed once after the module is loaded
+     *       and served from memory without locking, the name of the last
+     *       loaded version is kept while the module is unloaded. Before
+     *       the first load, the name is composed from the information
+     *       recorded by the manifest or the note. The module is never
+     *       loaded by this function: without a name, the type name
+     *       of extension::classname() is returned.
+     *
      * @note This function is declared as virtual to allow overrides
      *       in derived classes, ensuring that the correct type name
      *       is retrieved in a polymorphic hierarchy.
@@ -147,6 +251,177 @@ public:
     std::string
     classname() const override;
 
+    /**
+     * @brief Returns the manifest describing the module file.
+     * @return The manifest, or nullptr if none is used.
+     */
+    [[nodiscard]]
+    module_manifest *
+    manifest() const noexcept
+    {
+        return m_manifest;
+    }
+
+    /**
+     * @brief Sets the manifest describing the module file.
+     *
+     * While the module is not loaded, info() and classname() are answered
+     * from the manifest entry of an unchanged file, a pending module is not
+     * loaded for that. Every time the module is loaded, it is recorded in
+     * the manifest. Modules loaded from memory have no file to be recorded
+     * by and ignore the manifest.
+     *
+     * @param manifest The manifest, it must outlive the module,
+     *                 or nullptr to stop using one.
+     */
+    void
+    manifest(module_manifest *manifest);
+
+    /**
+     * @brief Sets the description answered while the module is not loaded.
+     *
+     * Used for modules whose description is known without a file, such as
+     * members of a module_bundle. The manifest does not replace it.
+     *
+     * @param description The description, or nullptr to drop it.
+     */
+    void
+    describe(std::shared_ptr<const module_manifest_entry> description) noexcept
+    {
+        m_entry = std::move(description);
+        notify_loader();
+    }
+
+    /**
+     * @brief Returns the worker preferred for the hooks of the module.
+     * @return The worker, or std::nullopt if any worker will do.
+     */
+    [[nodiscard]]
+    std::optional<std::size_t>
+    affinity() const noexcept
+    {
+        return m_affinity;
+    }
+
+    /**
+     * @brief Sets the worker preferred for the hooks of the module.
+     *
+     * Parallel broadcasts pass the hint to executor::submit_affine(),
+     * so that the hooks of the module tend to run on the same thread
+     * and find its data in the caches of that thread.
+     *
+     * @param worker The worker, or std::nullopt if any worker will do.
+     */
+    void
+    affinity(std::optional<std::size_t> worker) noexcept
+    {
+        m_affinity = worker;
+    }
+
+    /**
+     * @brief Returns the account of the heap memory allocated by the module.
+     *
+     * A new account is created every time the module is loaded while
+     * accounting is on, see memory_account. It is selected while the hooks of the module
+     * run, allocations of the platform loader are left to the host.
+     *
+     * @return The account of the last load, or nullptr if accounting
+     *         was off when the module was last loaded.
+     */
+    [[nodiscard]]
+    memory_account *
+    accounting() const noexcept
+    {
+        return m_account;
+    }
+
+    /**
+     * @brief Returns the counters of the heap memory allocated by the module
+     *        since it was last loaded.
+     *
+     * @return A snapshot of the counters, or std::nullopt without an account.
+     */
+    [[nodiscard]]
+    std::optional<memory_stats>
+    memory_usage() const noexcept
+    {
+        return m_account != nullptr ? std::optional(m_account->stats()) : std::nullopt;
+    }
+
+    /**
+     * @brief Returns the memory left allocated by the module when it was last
+     *        unloaded.
+     *
+     * Taken once on_module_unload returned and the arena was released,
+     * live bytes of the snapshot were not freed by the module. They are
+     * also reported to the logger as a warning.
+     *
+     * @return The counters of the account at the last unload,
+     *         or std::nullopt if the module was not unloaded with an account.
+     */
+    [[nodiscard]]
+    const std::optional<memory_stats> &
+    unfreed_memory() const noexcept
+    {
+        return m_unfreed;
+    }
+
+    /**
+     * @brief Returns the arena of the module.
+     *
+     * The arena is owned by the host, modules allocate their long-lived
+     * objects from it, typically from on_module_load. It is released at once
+     * after on_module_unload returned, by unload() or by reload(). It is kept
+     * only when reload() hands the state over, so that it may hold the state.
+     *
+     * @return The arena, its counters are read with module_arena::stats().
+     */
+    [[nodiscard]]
+    module_arena &
+    arena() noexcept
+    {
+        return m_arena;
+    }
+
+    /**
+     * @brief Returns the arena of the module (constant overload).
+     * @return The arena.
+     */
+    [[nodiscard]]
+    const module_arena &
+    arena() const noexcept
+    {
+        return m_arena;
+    }
+
+    /**
+     * @brief Returns the modules this module depends on.
+     *
+     * Dependencies are taken into account by the dynamic_loader:
+     * a module is loaded only after all of its dependencies are loaded
+     * and is unloaded before any of them.
+     *
+     * @return A constant reference to the list of dependencies.
+     */
+    [[nodiscard]]
+    const std::vector<dynamic_module *> &
+    dependencies() const noexcept
+    {
+        return m_dependencies;
+    }
+
+    /**
+     * @brief Declares that this module depends on another module.
+     *
+     * Declaring the same dependency more than once has no effect.
+     *
+     * @param module The module that must be loaded before this one.
+     *
+     * @throw dynamic_loader_error If the module depends on itself.
+     */
+    void
+    depends_on(dynamic_module &module);
+
     /**
      * @brief Constructs a dynamic_module object associated with a specified owner,
      *        logger, and library path.
@@ -187,6 +462,166 @@ public:
           dynamic_library(path)
     {
     }
+
+    /**
+     * @brief Constructs a dynamic_module loaded from memory.
+     *
+     * @param owner A reference to the owner entity.
+     * @param logger A reference to the logger.
+     * @param path The name of the module, no file has to exist.
+     * @param image The contents of the module, they must stay valid
+     *              as long as the module may be loaded.
+     *
+     * @see dynamic_library::dynamic_library(fs::path_t, std::span<const std::byte>)
+     */
+    template <typename OwnerType, typename LoggerType>
+    dynamic_module(OwnerType                 &&owner,
+                   LoggerType                  logger,
+                   const fs::path_t           &path,
+                   std::span<const std::byte>  image)
+        : extension(std::forward<OwnerType>(owner)),
+          logger_aware_class(std::forward<LoggerType>(logger)),
+          dynamic_library(path, image)
+    {
+    }
+
+    /**
+     * @brief Destroys the module, its memory account is released.
+     *
+     * Blocks still allocated from the account keep it alive until freed.
+     */
+    ~dynamic_module() override;
+
+protected:
+    /**
+     * @brief Returns the hooks every module has to export.
+     * @return The names of on_module_load, on_module_unload and on_module_info.
+     */
+    [[nodiscard]]
+    std::span<const std::string_view>
+    required_symbols() const noexcept override;
+
+    /**
+     * @brief Hands the state of the loaded version over on reload().
+     *
+     * If the loaded version exports on_module_export_state and the new one
+     * exports on_module_import_state, the pointer returned by the former is
+     * kept for the latter and no other hook runs, the arena is kept.
+     * Otherwise on_module_unload runs on the loaded version
+     * and the arena is released.
+     *
+     * @param current The handle of the loaded version.
+     * @param next The handle of the new version.
+     */
+    void
+    before_reload(os::dynamic_library_handle_t current,
+                  os::dynamic_library_handle_t next) override;
+
+    /**
+     * @brief Completes the state handover on reload().
+     *
+     * The module information and the class name are captured again, then the
+     * exported state is passed to on_module_import_state of the new version,
+     * or on_module_load runs on it if no state was exported.
+     *
+     * @param previous The handle of the replaced version.
+     */
+    void
+    after_reload(os::dynamic_library_handle_t previous) override;
+
+private:
+    /**
+     * @brief Captures the module information and the class name
+     *        of the freshly loaded module.
+     *
+     * @throw dynamic_library_error If the on_module_info function
+     *                              is not found within the library.
+     */
+    void
+    snapshot();
+
+    /**
+     * @brief Publishes the class name composed with a module name.
+     *
+     * Names are kept until the module is destroyed, so that classname()
+     * may copy the published name while another one is published.
+     *
+     * @param name The name of the module.
+     * @return The published class name.
+     */
+    const std::string &
+    publish_classname(std::string_view name) const;
+
+    /**
+     * @brief Returns the information of the module information note.
+     *
+     * The note is read from the file or the image once,
+     * the result is kept until the module is unloaded.
+     *
+     * @return The information, or nullptr if the module carries no note.
+     */
+    [[nodiscard]]
+    const module_info *
+    noted_info() const noexcept;
+
+    /**
+     * @brief Returns the information recorded in the manifest or in the note.
+     * @return The information, or nullptr if the module is loaded
+     *         or its file is neither described by the manifest nor noted.
+     */
+    [[nodiscard]]
+    const module_info *
+    recorded_info() const noexcept;
+
+    /**
+     * @brief Calls a hook of the module with its memory account selected.
+     *
+     * The hook is resolved before the account is selected,
+     * so that the symbol cache is not charged to the module.
+     *
+     * @param symbol The symbol of the hook.
+     * @param args Arguments to be passed to the hook.
+     * @return The result of the hook.
+     */
+    template <typename FunctionType, typename... Args>
+    std::invoke_result_t<FunctionType, Args...>
+    call_hook(const dl::symbol &symbol, Args &&...args)
+    {
+        static_cast<void>(sym(symbol));
+        memory_scope memory(m_account);
+        return call<FunctionType>(symbol, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Releases the arena and reports the memory left to the logger.
+     *
+     * The released arena is reported as debug information, the bytes left
+     * on the memory account as a warning.
+     */
+    void
+    release_memory();
+
+    /**
+     * @brief Tells the owning dynamic_loader, if any, that the module changed.
+     */
+    void
+    notify_loader() noexcept;
+
+    std::vector<dynamic_module *> m_dependencies;   ///< Modules loaded before this one.
+    const module_info            *m_info = nullptr; ///< Captured module information.
+    std::optional<void *>         m_state;          ///< State handed over on reload.
+    std::optional<std::size_t>    m_affinity;       ///< Worker preferred for hooks.
+    memory_account               *m_account = nullptr; ///< Heap memory of the module.
+    std::optional<memory_stats>   m_unfreed;           ///< Left on the last unload.
+    module_arena                  m_arena;             ///< Long-lived objects.
+    module_manifest              *m_manifest = nullptr; ///< Describes the file.
+    std::shared_ptr<const module_manifest_entry> m_entry; ///< The file when unloaded.
+    mutable std::mutex                           m_note_mutex; ///< Guards the note.
+    mutable std::shared_ptr<const module_info>   m_noted;      ///< The note when read.
+    mutable bool m_note_read = false; ///< Set once the note was looked for.
+    mutable std::atomic<const std::string *> m_classname{nullptr}; ///< Published name.
+    mutable std::mutex m_classname_mutex; ///< Serializes publications of the name.
+    mutable std::vector<std::unique_ptr<const std::string>> m_classnames; ///< Every name.
 };
 
 } // namespace mi
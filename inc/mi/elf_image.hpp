@@ -0,0 +1,154 @@
+/**
+ * @file elf_image.hpp
+ * @brief Defines the elf_image class, a bounds-checked reader
+ *        of ELF shared objects held in memory.
+ */
+
+#ifndef MI_ELF_IMAGE_HPP
+#define MI_ELF_IMAGE_HPP
+
+#include "dynamic_library_error.hpp"
+#include "os_def.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace mi::dl
+{
+
+/**
+ * @class elf_image
+ * @brief Reads the headers and dynamic tables of an ELF file without loading it.
+ *
+ * The image is a non-owning view, typically over a fs::mapped_file.
+ * Every offset read from the file is checked against the size of the view,
+ * so malformed files are reported as errors instead of being dereferenced.
+ *
+ * Only images of the native word size and byte order can be inspected,
+ * which are the only ones the running process could load anyway.
+ *
+ * @note ELF images are supported on Linux only,
+ *       on other platforms the constructor throws.
+ */
+class elf_image
+{
+public:
+    /**
+     * @brief Returns the machine the image is built for.
+     * @return The value of the e_machine field.
+     */
+    [[nodiscard]]
+    std::uint16_t
+    machine() const noexcept
+    {
+        return m_machine;
+    }
+
+    /**
+     * @brief Returns the type of the image.
+     * @return The value of the e_type field.
+     */
+    [[nodiscard]]
+    std::uint16_t
+    type() const noexcept
+    {
+        return m_type;
+    }
+
+    /**
+     * @brief Checks whether the image is a shared object
+     *        built for the machine of the running process.
+     *
+     * @return `true` if the process could load the image, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    is_loadable() const noexcept;
+
+    /**
+     * @brief Returns the names of the symbols the image exports.
+     *
+     * Only defined global, weak and unique symbols with default
+     * or protected visibility are returned.
+     *
+     * @return The exported symbol names, pointing into the image.
+     */
+    [[nodiscard]]
+    std::vector<std::string_view>
+    exported_symbols() const;
+
+    /**
+     * @brief Returns the descriptor of a note stored in the image.
+     *
+     * @param owner The name of the note owner, e.g. "GNU".
+     * @param type The type of the note.
+     * @return The descriptor of the first matching note, pointing into the image,
+     *         or an empty view if there is none.
+     */
+    [[nodiscard]]
+    std::span<const std::byte>
+    note(std::string_view owner, std::uint32_t type) const;
+
+    /**
+     * @brief Returns the build identifier of the image (NT_GNU_BUILD_ID).
+     * @return The identifier bytes, pointing into the image, empty if absent.
+     */
+    [[nodiscard]]
+    std::span<const std::byte>
+    build_id() const;
+
+    /**
+     * @brief Returns the libraries the image depends on (DT_NEEDED).
+     * @return The library names, pointing into the image.
+     */
+    [[nodiscard]]
+    std::vector<std::string_view>
+    needed() const;
+
+    /**
+     * @brief Returns the library search path of the image (DT_RUNPATH).
+     * @return The colon-separated search path, empty if absent.
+     */
+    [[nodiscard]]
+    std::string_view
+    runpath() const;
+
+    /**
+     * @brief Returns the legacy library search path of the image (DT_RPATH).
+     * @return The colon-separated search path, empty if absent.
+     */
+    [[nodiscard]]
+    std::string_view
+    rpath() const;
+
+    /**
+     * @brief Parses the header of an image.
+     *
+     * @param bytes The contents of the ELF file, which must outlive the image.
+     *
+     * @throw dynamic_library_error If the bytes are not a valid ELF file
+     *                              of the native word size and byte order.
+     */
+    explicit elf_image(std::span<const std::byte> bytes);
+
+private:
+    /**
+     * @brief Returns the string values of all dynamic entries with the given tag.
+     *
+     * @param tag The tag of the dynamic entries.
+     * @return The string values, pointing into the image.
+     */
+    [[nodiscard]]
+    std::vector<std::string_view>
+    dynamic_strings(std::int64_t tag) const;
+
+    std::span<const std::byte> m_bytes;   ///< The contents of the file.
+    std::uint16_t              m_machine; ///< The target machine.
+    std::uint16_t              m_type;    ///< The object file type.
+};
+
+} // namespace mi::dl
+
+#endif /* MI_ELF_IMAGE_HPP */
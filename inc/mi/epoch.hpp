@@ -0,0 +1,165 @@
+/**
+ * @file epoch.hpp
+ * @brief Defines the epoch_domain and epoch_guard classes, an epoch-based
+ *        reclamation scheme for data read without locking.
+ */
+
+#ifndef MI_EPOCH_HPP
+#define MI_EPOCH_HPP
+
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mi
+{
+
+/**
+ * @class epoch_domain
+ * @brief Defers the destruction of objects until no reader can observe them.
+ *
+ * Readers announce the epoch they entered in with an epoch_guard, writers
+ * unpublish an object and retire() it. A retired object is destroyed once
+ * every reader that could have loaded it has left its section, which is
+ * checked whenever an object is retired or reclaim() is called.
+ *
+ * The domain is process-wide. Every thread owns a reader record, taken on its
+ * first section and handed back when the thread exits, so entering a section
+ * costs an atomic load and a store followed by a fence.
+ */
+class epoch_domain : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @typedef deleter_t
+     * @brief Destroys a retired object.
+     */
+    using deleter_t = void (*)(void *) noexcept;
+
+    /**
+     * @brief Returns the process-wide domain.
+     * @return The domain.
+     */
+    [[nodiscard]]
+    static epoch_domain &
+    instance() noexcept;
+
+    /**
+     * @brief Enters a read-side section on the calling thread.
+     *
+     * Sections may be nested, only the outermost one announces an epoch.
+     */
+    void
+    enter() noexcept;
+
+    /**
+     * @brief Leaves a read-side section on the calling thread.
+     */
+    void
+    leave() noexcept;
+
+    /**
+     * @brief Destroys an unpublished object once no reader can observe it.
+     *
+     * @param object The object, it must not be reachable by new readers.
+     * @param deleter Destroys the object.
+     */
+    void
+    retire(void *object, deleter_t deleter);
+
+    /**
+     * @brief Destroys an unpublished object once no reader can observe it.
+     * @param object The object, it must not be reachable by new readers.
+     */
+    template <typename ObjectType>
+    void
+    retire(ObjectType *object)
+    {
+        retire(object,
+               [](void *pointer) noexcept
+               {
+                   delete static_cast<ObjectType *>(pointer);
+               });
+    }
+
+    /**
+     * @brief Destroys the retired objects no reader can observe anymore.
+     * @return The number of objects still waiting for readers.
+     */
+    std::size_t
+    reclaim();
+
+private:
+    /**
+     * @struct reader
+     * @brief The record announcing the epoch of a reading thread.
+     */
+    struct reader;
+
+    /**
+     * @struct retired
+     * @brief An object waiting for the readers that may observe it.
+     */
+    struct retired
+    {
+        std::uint64_t epoch;   ///< The epoch the object was retired in.
+        void         *object;  ///< The object.
+        deleter_t     deleter; ///< Destroys the object.
+    };
+
+    /**
+     * @brief Returns the record of the calling thread, taking one if needed.
+     */
+    reader &
+    local_reader() noexcept;
+
+    /**
+     * @brief Returns the oldest epoch announced by a reader.
+     */
+    std::uint64_t
+    oldest_epoch() const noexcept;
+
+    epoch_domain() noexcept = default;
+
+    std::atomic<std::uint64_t> m_epoch{1};        ///< The current epoch.
+    std::atomic<reader *>      m_readers{nullptr}; ///< The records, never freed.
+    std::mutex                 m_mutex;           ///< Guards the retired objects.
+    std::vector<retired>       m_retired;         ///< Waiting for readers.
+};
+
+/**
+ * @class epoch_guard
+ * @brief Keeps the objects loaded by the calling thread alive while it exists.
+ *
+ * @code
+ * mi::epoch_guard guard;
+ * const auto *list = published.load(std::memory_order_acquire);
+ * // list stays valid until the guard is destroyed
+ * @endcode
+ */
+class epoch_guard : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Enters a read-side section.
+     */
+    epoch_guard() noexcept
+    {
+        epoch_domain::instance().enter();
+    }
+
+    /**
+     * @brief Leaves the read-side section.
+     */
+    ~epoch_guard()
+    {
+        epoch_domain::instance().leave();
+    }
+};
+
+} // namespace mi
+
+#endif /* MI_EPOCH_HPP */
@@ -7,6 +7,7 @@
 #ifndef MI_EXCEPTION_HPP
 #define MI_EXCEPTION_HPP
 
+#include "builtin.hpp"
 #include <exception>
 #include <functional>
 
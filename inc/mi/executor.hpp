@@ -0,0 +1,69 @@
+/**
+ * @file executor.hpp
+ * @brief Defines the executor interface running tasks on behalf of the library.
+ */
+
+#ifndef MI_EXECUTOR_HPP
+#define MI_EXECUTOR_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace mi
+{
+
+/**
+ * @class executor
+ * @brief Abstract runner of tasks.
+ *
+ * The asynchronous lifecycle functions of dynamic_module hand their work to
+ * an executor, so that it runs wherever the host wants it to, e.g. on a
+ * thread_pool or on the worker threads of an event loop.
+ *
+ * @note Tasks must not throw, the library captures failures itself.
+ */
+class executor
+{
+public:
+    /**
+     * @typedef task_t
+     * @brief The type of a unit of work executed by the executor.
+     */
+    using task_t = std::function<void()>;
+
+    /**
+     * @brief Queues a task for execution.
+     *
+     * The task may run on any thread, but not on the calling thread
+     * before submit() returns.
+     *
+     * @param task The task to execute.
+     */
+    virtual void
+    submit(task_t task) = 0;
+
+    /**
+     * @brief Queues a task for execution, preferably on a given worker.
+     *
+     * Executors without workers of their own ignore the hint,
+     * which is what the default implementation does.
+     *
+     * @param task The task to execute.
+     * @param affinity The preferred worker, taken modulo the number of workers.
+     */
+    virtual void
+    submit_affine(task_t task, std::size_t affinity)
+    {
+        (void)affinity;
+        submit(std::move(task));
+    }
+
+    /**
+     * @brief Destroys the executor.
+     */
+    virtual ~executor() = default;
+};
+
+} // namespace mi
+
+#endif /* MI_EXECUTOR_HPP */
@@ -9,6 +9,8 @@
 #include "base_loader.hpp"
 #include "owner_aware_class.hpp"
 #include <boost/type_index.hpp>
+#include <mutex>
+#include <string>
 
 namespace mi
 {
@@ -25,8 +27,11 @@ namespace mi
  * The protection level of inheritance ensures the encapsulation of
  * owner_aware_class functionalities, making them accessible only within
  * extension or derived classes.
+ *
+ * The owner of an extension is the extension that attached it, which allows
+ * both extension_loader and dynamic_loader to act as owners.
  */
-class extension : protected mixin::owner_aware_class<const base_loader<extension>>
+class extension : protected mixin::owner_aware_class<const extension>
 {
 public:
     /**
@@ -44,14 +49,27 @@ public:
      * This approach allows fetching the class name in a human-readable format,
      * aiding in debug or logging processes.
      *
+     * @note The name is composed by the first call and served from memory
+     *       afterwards, it must not be called before the instance is fully
+     *       constructed.
+     *
      * @return std::string The pretty name of the class type.
      */
     [[nodiscard]]
-    virtual inline std::string
+    virtual std::string
     classname() const
     {
-        return boost::typeindex::type_id_runtime(*this).pretty_name();
+        std::call_once(m_typename_once,
+                       [this]()
+                       {
+                           m_typename = boost::typeindex::type_id_runtime(*this).pretty_name();
+                       });
+        return m_typename;
     }
+
+private:
+    mutable std::once_flag m_typename_once; ///< Composes the type name once.
+    mutable std::string    m_typename;      ///< The pretty name of the type.
 };
 
 } // namespace mi
@@ -7,6 +7,7 @@
 #ifndef MI_FORMAT_HPP
 #define MI_FORMAT_HPP
 
+#include <sstream>
 #include <string>
 
 namespace mi::format
@@ -14,6 +14,7 @@
 #define MI_FS_HPP
 
 #include <filesystem>
+#include <string_view>
 
 /**
  * @namespace mi::fs
@@ -112,6 +113,21 @@ is_writable(const path_t &path);
 bool
 is_executable(const path_t &path);
 
+/**
+ * @brief Replaces the contents of a file atomically.
+ *
+ * The contents are written to a temporary file next to the path, which is
+ * then renamed over it, so readers observe either the previous contents or
+ * the new ones, never a partially written file.
+ *
+ * @param path The path of the file to replace.
+ * @param contents The new contents of the file.
+ *
+ * @throws fs_error If the file cannot be written or renamed into place.
+ */
+void
+replace_file(const path_t &path, std::string_view contents);
+
 } // namespace mi::fs
 
 #endif /* MI_FS_HPP */
@@ -0,0 +1,27 @@
+/**
+ * @file fs_error.hpp
+ * @brief Defines the mi::exception::fs_error class.
+ *
+ * This header file extends the custom exception types provided by the MI library
+ * to include an exception for file system errors raised by the MI library itself.
+ */
+
+#ifndef MI_FS_ERROR_HPP
+#define MI_FS_ERROR_HPP
+
+#include "runtime_error.hpp"
+
+namespace mi::exception
+{
+
+/**
+ * @brief Declare a new error class for file system errors.
+ * @details Utilizes the MI_DECLARE_NEW_ERROR_CLASS macro from "runtime_error.hpp"
+ *          to define a new exception class that inherits
+ *          from mi::exception::runtime_error.
+ */
+MI_DECLARE_NEW_ERROR_CLASS(fs_error);
+
+} // namespace mi::exception
+
+#endif /* MI_FS_ERROR_HPP */
@@ -0,0 +1,104 @@
+/**
+ * @file gnu_hash_resolver.hpp
+ * @brief Defines the gnu_hash_resolver class, which resolves symbols
+ *        of a loaded library without going through the platform loader.
+ */
+
+#ifndef MI_GNU_HASH_RESOLVER_HPP
+#define MI_GNU_HASH_RESOLVER_HPP
+
+#include "dynamic_library.hpp"
+#include <cstdint>
+
+namespace mi::dl
+{
+
+/**
+ * @class gnu_hash_resolver
+ * @brief Resolves symbols by walking the GNU hash table of a loaded library.
+ *
+ * dlsym serializes all lookups on the global lock of the dynamic linker.
+ * This resolver locates the DT_GNU_HASH, DT_SYMTAB and DT_STRTAB tables
+ * of the library once, using dl_iterate_phdr, and then looks up symbols
+ * directly in the mapped tables. The tables are read-only, hence any number
+ * of threads may resolve symbols concurrently without locking.
+ *
+ * The resolver falls back to the platform loader for symbols it cannot
+ * resolve correctly on its own:
+ * - versioned symbols, whose default version has to be chosen,
+ * - IFUNC symbols, whose address is computed by a resolver function,
+ * - TLS symbols, whose address is thread-specific,
+ * - symbols not defined in the library itself, but in its dependencies.
+ *
+ * On platforms without GNU hash tables, and for libraries whose table
+ * has no bucket or no bloom word, every lookup is forwarded
+ * to dynamic_library::sym_unsafe().
+ *
+ * @warning The resolver is bound to the handle the library had at
+ *          construction time. It must be recreated after the library
+ *          is reloaded and must not be used after it is unloaded.
+ */
+class gnu_hash_resolver : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Checks whether the hash table of the library was found.
+     *
+     * @return `true` if lookups are served from the hash table,
+     *         `false` if all lookups are forwarded to the platform loader.
+     */
+    [[nodiscard]]
+    bool
+    is_indexed() const noexcept
+    {
+        return m_buckets != nullptr;
+    }
+
+    /**
+     * @brief Resolves a symbol of the library.
+     *
+     * @param name The name of the symbol to resolve.
+     * @return A pointer to the symbol if found, otherwise nullptr.
+     */
+    [[nodiscard]]
+    os::dynamic_library_func_t
+    resolve(std::string_view name) const;
+
+    /**
+     * @brief Locates the hash table of a loaded library.
+     *
+     * @param library The library to resolve symbols from.
+     *
+     * @throw dynamic_library_error If the library is not loaded.
+     */
+    explicit gnu_hash_resolver(const dynamic_library &library);
+
+private:
+    /**
+     * @brief Looks up a symbol in the hash table.
+     *
+     * @param name The name of the symbol.
+     * @return The address of the symbol, or nullptr if it is not defined
+     *         in the library or must be resolved by the platform loader.
+     */
+    [[nodiscard]]
+    os::dynamic_library_func_t
+    lookup(std::string_view name) const noexcept;
+
+    const dynamic_library &m_library;                 ///< The library being resolved.
+    std::uintptr_t         m_base          = 0;       ///< The load bias of the library.
+    const void            *m_symtab        = nullptr; ///< The dynamic symbol table.
+    const char            *m_strtab        = nullptr; ///< The dynamic string table.
+    const std::uint16_t   *m_versym        = nullptr; ///< The symbol version table.
+    const std::uintptr_t  *m_bloom         = nullptr; ///< The bloom filter words.
+    const std::uint32_t   *m_buckets       = nullptr; ///< The hash buckets.
+    const std::uint32_t   *m_chain         = nullptr; ///< The hash chains.
+    std::uint32_t          m_bucket_count  = 0;       ///< The number of buckets.
+    std::uint32_t          m_symbol_offset = 0;       ///< The first hashed symbol.
+    std::uint32_t          m_bloom_size    = 0;       ///< The number of bloom words.
+    std::uint32_t          m_bloom_shift   = 0;       ///< The second bloom hash shift.
+};
+
+} // namespace mi::dl
+
+#endif /* MI_GNU_HASH_RESOLVER_HPP */
@@ -0,0 +1,258 @@
+/**
+ * @file interface_table.hpp
+ * @brief Defines the interface_table and binding classes which describe
+ *        a plugin interface as a table of typed function pointers.
+ *
+ * An interface is declared once as a structure of bindings:
+ *
+ * @code
+ * struct plugin_api : mi::dl::interface_table
+ * {
+ *     mi::dl::binding<int(int, int)> add{*this, "add"};
+ *     mi::dl::binding<void()>        tick{*this, "on_tick", false};
+ * };
+ *
+ * plugin_api api;
+ * library.bind(api);
+ * library.load();
+ * api.add(2, 3);
+ * @endcode
+ *
+ * All bindings are resolved in one pass when the library is loaded,
+ * after that calls go straight through the stored function pointers.
+ */
+
+#ifndef MI_INTERFACE_TABLE_HPP
+#define MI_INTERFACE_TABLE_HPP
+
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include "os.hpp"
+#include "symbol_cache.hpp"
+#include <utility>
+#include <vector>
+
+namespace mi::dl
+{
+
+class interface_table;
+
+/**
+ * @class binding_base
+ * @brief The type-erased part of a binding, used to resolve it.
+ */
+class binding_base : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Returns the symbol the binding is resolved from.
+     * @return The symbol with its precomputed hash.
+     */
+    [[nodiscard]]
+    const dl::symbol &
+    symbol() const noexcept
+    {
+        return m_symbol;
+    }
+
+    /**
+     * @brief Checks whether the symbol must be exported by the library.
+     * @return `true` if loading fails without the symbol, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    is_required() const noexcept
+    {
+        return m_required;
+    }
+
+    /**
+     * @brief Checks whether the binding holds a resolved address.
+     * @return `true` if the binding is resolved, `false` otherwise.
+     */
+    [[nodiscard]]
+    virtual bool
+    is_bound() const noexcept = 0;
+
+    /**
+     * @brief Stores a resolved address in the binding.
+     * @param address The resolved address, or nullptr to reset the binding.
+     */
+    virtual void
+    assign(os::dynamic_library_func_t address) noexcept = 0;
+
+protected:
+    /**
+     * @brief Constructs a binding and registers it within its table.
+     *
+     * @param table The table the binding belongs to.
+     * @param name The name of the exported symbol,
+     *             the referenced characters must outlive the binding.
+     *
+     * @param required Whether the library must export the symbol.
+     */
+    binding_base(interface_table &table, std::string_view name, bool required);
+
+private:
+    dl::symbol m_symbol;   ///< The exported symbol.
+    bool       m_required; ///< Whether the symbol is mandatory.
+};
+
+/**
+ * @class interface_table
+ * @brief A set of bindings resolved together by a dynamic_library.
+ *
+ * The table is meant to be used as a base class of a structure whose members
+ * are bindings. Every binding registers itself in the table on construction.
+ *
+ * @see dynamic_library::bind()
+ */
+class interface_table : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Returns the bindings of the table in declaration order.
+     * @return A constant reference to the list of bindings.
+     */
+    [[nodiscard]]
+    const std::vector<binding_base *> &
+    bindings() const noexcept
+    {
+        return m_bindings;
+    }
+
+    /**
+     * @brief Checks whether every required binding is resolved.
+     * @return `true` if all required bindings are resolved, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    is_bound() const noexcept
+    {
+        for (const auto *binding : m_bindings)
+        {
+            if (binding->is_required() && !binding->is_bound())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Resets every binding of the table.
+     */
+    void
+    reset() noexcept
+    {
+        for (auto *binding : m_bindings)
+        {
+            binding->assign(nullptr);
+        }
+    }
+
+    /**
+     * @brief Constructs an empty table.
+     */
+    interface_table() = default;
+
+private:
+    friend class binding_base;
+
+    std::vector<binding_base *> m_bindings; ///< Registered bindings.
+};
+
+inline binding_base::binding_base(interface_table &table,
+                                  std::string_view name,
+                                  bool             required)
+    : m_symbol(name),
+      m_required(required)
+{
+    table.m_bindings.push_back(this);
+}
+
+/**
+ * @class binding
+ * @brief A typed function pointer resolved from a dynamic library.
+ *
+ * @tparam FunctionType The signature of the exported function.
+ */
+template <typename FunctionType>
+class binding final : public binding_base
+{
+public:
+    /**
+     * @brief Constructs an unresolved binding.
+     *
+     * @param table The table the binding belongs to.
+     * @param name The name of the exported function.
+     * @param required Whether the library must export the function.
+     */
+    binding(interface_table &table, std::string_view name, bool required = true)
+        : binding_base(table, name, required),
+          m_function(nullptr)
+    {
+    }
+
+    /**
+     * @brief Returns the resolved function pointer.
+     * @return The function pointer, or nullptr if the binding is not resolved.
+     */
+    [[nodiscard]]
+    FunctionType *
+    get() const noexcept
+    {
+        return m_function;
+    }
+
+    /**
+     * @copydoc binding_base::is_bound()
+     */
+    [[nodiscard]]
+    bool
+    is_bound() const noexcept override
+    {
+        return m_function != nullptr;
+    }
+
+    /**
+     * @copydoc binding_base::assign()
+     */
+    void
+    assign(os::dynamic_library_func_t address) noexcept override
+    {
+        m_function = reinterpret_cast<FunctionType *>(address);
+    }
+
+    /**
+     * @brief Calls the resolved function.
+     *
+     * @param args Arguments to be passed to the function.
+     * @return The result of the function.
+     *
+     * @warning The binding must be resolved, which is guaranteed for required
+     *          bindings while the library is loaded.
+     */
+    template <typename... Args>
+    decltype(auto)
+    operator()(Args &&...args) const
+    {
+        return m_function(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Checks whether the binding is resolved.
+     */
+    explicit
+    operator bool() const noexcept
+    {
+        return is_bound();
+    }
+
+private:
+    FunctionType *m_function; ///< The resolved function.
+};
+
+} // namespace mi::dl
+
+#endif /* MI_INTERFACE_TABLE_HPP */
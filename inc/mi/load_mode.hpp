@@ -0,0 +1,33 @@
+/**
+ * @file load_mode.hpp
+ * @brief Contains the enumeration of module load modes used by the dynamic loader.
+ */
+
+#ifndef MI_LOAD_MODE_HPP
+#define MI_LOAD_MODE_HPP
+
+namespace mi
+{
+
+/**
+ * @enum load_mode
+ * @brief Enumerates the strategies used to load and unload attached modules.
+ *
+ * @var load_mode::LOAD_MODE_SEQUENTIAL
+ *      Modules are processed one after another on the calling thread,
+ *      in dependency order and otherwise in the order they were attached.
+ *
+ * @var load_mode::LOAD_MODE_PARALLEL
+ *      Modules are processed on a pool of worker threads. A module is loaded
+ *      as soon as all of its dependencies are loaded and unloaded as soon as
+ *      all of its dependents are unloaded.
+ */
+enum load_mode : unsigned char
+{
+    LOAD_MODE_SEQUENTIAL = 0, /**< One module at a time on the calling thread. */
+    LOAD_MODE_PARALLEL   = 1  /**< Independent modules concurrently. */
+};
+
+} // namespace mi
+
+#endif /* MI_LOAD_MODE_HPP */
@@ -0,0 +1,100 @@
+/**
+ * @file load_policy_flags.hpp
+ * @brief Contains the flags controlling how a dynamic library is opened.
+ *
+ * The flags map to the dlopen mode on UNIX-like systems,
+ * where binding and symbol visibility of a library can be configured.
+ */
+
+#ifndef MI_LOAD_POLICY_FLAGS_HPP
+#define MI_LOAD_POLICY_FLAGS_HPP
+
+namespace mi
+{
+
+/**
+ * @enum load_policy_flags
+ * @brief Enumerates the options used when opening a dynamic library.
+ *
+ * The flags can be combined, an empty set selects lazy binding
+ * and local symbol visibility.
+ *
+ * @var LOAD_POLICY_NONE_FLAGS
+ *      Lazy binding and local visibility (RTLD_LAZY | RTLD_LOCAL),
+ *      function references are resolved on their first call.
+ *
+ * @var LOAD_POLICY_NOW_FLAG
+ *      All references are resolved before the library is opened (RTLD_NOW),
+ *      moving the binding cost from the first calls into load().
+ *
+ * @var LOAD_POLICY_GLOBAL_FLAG
+ *      The symbols of the library are made available to the libraries
+ *      opened after it (RTLD_GLOBAL).
+ *
+ * @var LOAD_POLICY_NODELETE_FLAG
+ *      The library is not removed from memory when closed (RTLD_NODELETE),
+ *      so addresses obtained from it stay valid.
+ *
+ * @var LOAD_POLICY_DEEPBIND_FLAG
+ *      The library prefers its own symbols over those already in the global
+ *      scope (RTLD_DEEPBIND), supported by glibc only.
+ *
+ * @var LOAD_POLICY_DESCRIPTOR_FLAG
+ *      The library is opened through the descriptor its file was checked on
+ *      (/proc/self/fd), so the platform loader neither resolves the path again
+ *      nor can be handed a file swapped in after the checks. Supported on
+ *      Linux only. $ORIGIN in the search paths of such a library refers to
+ *      /proc/self/fd rather than to the directory of the library.
+ *
+ * @var LOAD_POLICY_SHARED_FLAG
+ *      Libraries opened from the same file, by any path, or from the same
+ *      in-memory image share one handle and one symbol cache through a
+ *      process-wide registry. Only the first load opens the library and only
+ *      the last unload closes it, so many instances of a module are cheap.
+ *      The instances share the static state of the library. Supported on
+ *      Linux only, shared libraries cannot be reloaded.
+ *
+ * @note On Windows libraries are always bound when opened and share no scope,
+ *       the flags have no effect there.
+ */
+enum load_policy_flags : unsigned char
+{
+    /**
+     * @brief Lazy binding, local visibility.
+     */
+    LOAD_POLICY_NONE_FLAGS = 0,
+
+    /**
+     * @brief Immediate binding.
+     */
+    LOAD_POLICY_NOW_FLAG = (1 << 0),
+
+    /**
+     * @brief Global visibility.
+     */
+    LOAD_POLICY_GLOBAL_FLAG = (1 << 1),
+
+    /**
+     * @brief Never unmapped once opened.
+     */
+    LOAD_POLICY_NODELETE_FLAG = (1 << 2),
+
+    /**
+     * @brief Own symbols take precedence.
+     */
+    LOAD_POLICY_DEEPBIND_FLAG = (1 << 3),
+
+    /**
+     * @brief Opened through the checked descriptor.
+     */
+    LOAD_POLICY_DESCRIPTOR_FLAG = (1 << 4),
+
+    /**
+     * @brief Handle shared with the libraries opened from the same file.
+     */
+    LOAD_POLICY_SHARED_FLAG = (1 << 5)
+};
+
+} // namespace mi
+
+#endif /* MI_LOAD_POLICY_FLAGS_HPP */
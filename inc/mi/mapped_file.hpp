@@ -0,0 +1,77 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Defines the mapped_file class, a read-only memory mapping of a file.
+ */
+
+#ifndef MI_MAPPED_FILE_HPP
+#define MI_MAPPED_FILE_HPP
+
+#include "fs.hpp"
+#include "noncopyable.hpp"
+#include <cstddef>
+#include <span>
+
+namespace mi::fs
+{
+
+/**
+ * @class mapped_file
+ * @brief Maps a whole file into memory for reading.
+ *
+ * The mapping is private and read-only, so inspecting a file this way
+ * has no side effects on the process beyond the address space it occupies.
+ * Empty files are represented by an empty view without a mapping.
+ */
+class mapped_file : private mixin::noncopyable
+{
+public:
+    /**
+     * @brief Returns the mapped bytes.
+     * @return A view of the file contents.
+     */
+    [[nodiscard]]
+    std::span<const std::byte>
+    bytes() const noexcept
+    {
+        return {static_cast<const std::byte *>(m_data), m_size};
+    }
+
+    /**
+     * @brief Returns the size of the mapped file.
+     * @return The size in bytes.
+     */
+    [[nodiscard]]
+    std::size_t
+    size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Maps the file at the given path.
+     *
+     * @param path The path of the file to map.
+     *
+     * @throw fs_error If the file cannot be opened or mapped.
+     */
+    explicit mapped_file(const path_t &path);
+
+    /**
+     * @brief Takes over the mapping of another mapped_file.
+     * @param other The mapping to take over, left empty.
+     */
+    mapped_file(mapped_file &&other) noexcept;
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~mapped_file() override;
+
+private:
+    const void *m_data; ///< The start of the mapping.
+    std::size_t m_size; ///< The length of the mapping.
+};
+
+} // namespace mi::fs
+
+#endif /* MI_MAPPED_FILE_HPP */
@@ -0,0 +1,226 @@
+/**
+ * @file memory_account.hpp
+ * @brief Defines the memory_account class attributing heap allocations
+ *        to modules and the memory_scope class selecting the account.
+ */
+
+#ifndef MI_MEMORY_ACCOUNT_HPP
+#define MI_MEMORY_ACCOUNT_HPP
+
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace mi
+{
+
+/**
+ * @struct memory_stats
+ * @brief A snapshot of the counters of a memory account.
+ */
+struct memory_stats
+{
+    std::uint64_t                         live_bytes;      ///< Bytes not freed yet.
+    std::uint64_t                         peak_bytes;      ///< Highest live bytes.
+    std::uint64_t                         allocated_bytes; ///< Bytes ever allocated.
+    std::uint64_t                         allocations;     ///< Blocks ever allocated.
+    std::uint64_t                         deallocations;   ///< Blocks freed.
+    std::chrono::steady_clock::time_point time;            ///< When it was taken.
+
+    /**
+     * @brief Returns the allocation rate between an earlier snapshot and this one.
+     *
+     * @param earlier A snapshot of the same account taken before this one.
+     * @return The number of allocations per second, 0 if no time elapsed.
+     */
+    [[nodiscard]]
+    double
+    allocation_rate(const memory_stats &earlier) const noexcept
+    {
+        const auto elapsed = std::chrono::duration<double>(time - earlier.time).count();
+        return elapsed > 0 ? static_cast<double>(allocations - earlier.allocations) / elapsed
+                           : 0;
+    }
+};
+
+/**
+ * @class memory_account
+ * @brief Lock-free counters of the heap memory attributed to a module.
+ *
+ * Allocations are attributed to the account selected on the allocating
+ * thread by a memory_scope, dynamic modules select their account around
+ * their hooks. Frees are attributed to the account the block was allocated
+ * from, whichever thread frees it.
+ *
+ * Allocations are observed by the global operator new and operator delete
+ * of the library, which replace the default ones when the library is built
+ * with MI_MEMORY_ACCOUNTING. Every block then carries a small header.
+ * Blocks of aligned operator new and of malloc() are not accounted.
+ *
+ * Accounting is off until enable() is called. While it is off,
+ * a memory_scope costs a single branch and no block is attributed.
+ *
+ * Accounts are reference counted: a block keeps its account alive,
+ * so blocks leaked by a module can be freed after the module is gone.
+ */
+class memory_account : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Checks if allocations are observed by the library.
+     * @return `true` if the library was built with MI_MEMORY_ACCOUNTING.
+     */
+    [[nodiscard]]
+    static bool
+    supported() noexcept;
+
+    /**
+     * @brief Checks if allocations are being attributed.
+     * @return `true` if accounting is on.
+     */
+    [[nodiscard]]
+    static bool
+    enabled() noexcept
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Turns accounting on or off.
+     *
+     * Modules loaded while accounting is off have no account,
+     * they are given one the next time they are loaded.
+     *
+     * @param enabled `true` to attribute allocations.
+     */
+    static void
+    enable(bool enabled) noexcept
+    {
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the account selected on the calling thread.
+     * @return The account, or nullptr if allocations are not attributed.
+     */
+    [[nodiscard]]
+    static memory_account *
+    current() noexcept
+    {
+        return t_current;
+    }
+
+    /**
+     * @brief Creates an account holding a single reference.
+     * @return The account, released with release().
+     */
+    [[nodiscard]]
+    static memory_account *
+    create();
+
+    /**
+     * @brief Adds a reference to the account.
+     */
+    void
+    retain() noexcept
+    {
+        m_references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Drops a reference, the account is destroyed with the last one.
+     */
+    void
+    release() noexcept;
+
+    /**
+     * @brief Attributes an allocated block to the account.
+     *
+     * The block holds a reference to the account until it is freed.
+     *
+     * @param size The size of the block.
+     */
+    void
+    allocated(std::size_t size) noexcept;
+
+    /**
+     * @brief Takes a freed block off the account and drops its reference.
+     * @param size The size of the block.
+     */
+    void
+    freed(std::size_t size) noexcept;
+
+    /**
+     * @brief Returns the current values of the counters.
+     * @return A snapshot of the counters.
+     */
+    [[nodiscard]]
+    memory_stats
+    stats() const noexcept;
+
+private:
+    friend class memory_scope;
+
+    /**
+     * @brief Constructs an account holding a single reference.
+     */
+    memory_account() = default;
+
+    std::atomic<std::uint64_t> m_live{0};          ///< Bytes not freed yet.
+    std::atomic<std::uint64_t> m_peak{0};          ///< Highest live bytes.
+    std::atomic<std::uint64_t> m_allocated{0};     ///< Bytes ever allocated.
+    std::atomic<std::uint64_t> m_allocations{0};   ///< Blocks ever allocated.
+    std::atomic<std::uint64_t> m_deallocations{0}; ///< Blocks freed.
+    std::atomic<std::size_t>   m_references{1};    ///< The owner and live blocks.
+
+    static inline std::atomic<bool> s_enabled{false}; ///< Accounting is on.
+    static inline thread_local memory_account *t_current = nullptr; ///< Selected.
+};
+
+/**
+ * @class memory_scope
+ * @brief Selects the account of the calling thread during its lifetime.
+ *
+ * Scopes nest, the previously selected account is restored on destruction.
+ * A scope selecting nullptr attributes allocations to no account, such as
+ * the allocations of the host made from within a hook of another module.
+ */
+class memory_scope : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Selects an account.
+     * @param account The account, or nullptr.
+     */
+    explicit memory_scope(memory_account *account) noexcept
+        : m_enabled(memory_account::enabled())
+    {
+        if (m_enabled)
+        {
+            m_previous                = memory_account::t_current;
+            memory_account::t_current = account;
+        }
+    }
+
+    /**
+     * @brief Restores the previously selected account.
+     */
+    ~memory_scope() override
+    {
+        if (m_enabled)
+        {
+            memory_account::t_current = m_previous;
+        }
+    }
+
+private:
+    bool            m_enabled;            ///< Accounting was on at construction.
+    memory_account *m_previous = nullptr; ///< The account to restore.
+};
+
+} // namespace mi
+
+#endif /* MI_MEMORY_ACCOUNT_HPP */
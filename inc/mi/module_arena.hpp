@@ -0,0 +1,137 @@
+/**
+ * @file module_arena.hpp
+ * @brief Defines the module_arena class, a monotonic memory resource
+ *        owned by the host on behalf of a module.
+ */
+
+#ifndef MI_MODULE_ARENA_HPP
+#define MI_MODULE_ARENA_HPP
+
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+
+namespace mi
+{
+
+/**
+ * @struct arena_stats
+ * @brief A snapshot of the counters of a module arena.
+ */
+struct arena_stats
+{
+    std::uint64_t used_bytes;     ///< Bytes handed out since the last release.
+    std::uint64_t reserved_bytes; ///< Bytes of the chunks held by the arena.
+    std::uint64_t allocations;    ///< Blocks handed out since the last release.
+    std::uint64_t chunks;         ///< Chunks held by the arena.
+    std::uint64_t releases;       ///< Times the arena was released.
+};
+
+/**
+ * @class module_arena
+ * @brief A monotonic arena for the long-lived objects of a module.
+ *
+ * Blocks are carved out of chunks obtained from the global operator new and
+ * are never freed one by one: deallocation is a no-op, the chunks are freed
+ * all at once by release(), which a dynamic_module does when it is unloaded.
+ * Objects left in the arena are not destroyed, they must not own resources
+ * other than memory of the same arena.
+ *
+ * The arena is a std::pmr::memory_resource, so that modules can build
+ * their containers on it. Allocations are serialized by a mutex,
+ * hooks of a module running on several threads may share the arena.
+ */
+class module_arena final : public std::pmr::memory_resource,
+                           private mixin::noncopyable,
+                           private mixin::nonmovable
+{
+public:
+    /**
+     * @brief The default size of a chunk.
+     */
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Frees every chunk, invalidating every block of the arena.
+     *
+     * Takes time proportional to the number of chunks,
+     * not to the number of blocks.
+     */
+    void
+    release() noexcept;
+
+    /**
+     * @brief Returns the current values of the counters.
+     * @return A snapshot of the counters.
+     */
+    [[nodiscard]]
+    arena_stats
+    stats() const noexcept;
+
+    /**
+     * @brief Constructs an arena holding no chunk.
+     * @param chunk_size The size of the chunks, larger blocks get a chunk of their own.
+     */
+    explicit module_arena(std::size_t chunk_size = CHUNK_SIZE) noexcept
+        : m_chunk_size(chunk_size)
+    {
+    }
+
+    /**
+     * @brief Destroys the arena, its chunks are freed.
+     */
+    ~module_arena() override;
+
+protected:
+    /**
+     * @brief Carves a block out of the current chunk, or out of a new one.
+     *
+     * @param bytes The size of the block.
+     * @param alignment The alignment of the block, a power of two.
+     *
+     * @return The block.
+     *
+     * @throw std::bad_alloc If no chunk can be allocated.
+     */
+    void *
+    do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    /**
+     * @brief Does nothing, blocks are freed by release().
+     */
+    void
+    do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+
+    /**
+     * @brief Checks if blocks of another resource can be freed by this arena.
+     * @return `true` only for the arena itself.
+     */
+    [[nodiscard]]
+    bool
+    do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+    /**
+     * @struct chunk
+     * @brief Precedes the blocks of every chunk.
+     */
+    struct chunk
+    {
+        chunk      *next; ///< The chunk allocated before.
+        std::size_t size; ///< The size of the chunk, header included.
+    };
+
+    std::size_t        m_chunk_size;       ///< The default size of a chunk.
+    mutable std::mutex m_mutex;            ///< Guards the chunks and counters.
+    chunk             *m_chunks = nullptr; ///< The most recent chunk.
+    std::byte         *m_cursor = nullptr; ///< The free space of the current chunk.
+    std::byte         *m_end    = nullptr; ///< The end of the current chunk.
+    arena_stats        m_stats  = {};      ///< The counters.
+};
+
+} // namespace mi
+
+#endif /* MI_MODULE_ARENA_HPP */
@@ -0,0 +1,136 @@
+/**
+ * @file module_bundle.hpp
+ * @brief Defines the module_bundle class, a single file holding the images
+ *        of many modules together with their descriptions.
+ */
+
+#ifndef MI_MODULE_BUNDLE_HPP
+#define MI_MODULE_BUNDLE_HPP
+
+#include "fs.hpp"
+#include "mapped_file.hpp"
+#include "module_manifest.hpp"
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mi
+{
+
+/**
+ * @struct module_bundle_member
+ * @brief A module image stored in a bundle.
+ */
+struct module_bundle_member
+{
+    std::string                                  name;  ///< The file name of the module.
+    std::span<const std::byte>                   image; ///< The image, in the mapping.
+    std::shared_ptr<const module_manifest_entry> description; ///< Build id and info.
+};
+
+/**
+ * @struct module_bundle_source
+ * @brief A module file to be stored in a bundle by module_bundle::write().
+ */
+struct module_bundle_source
+{
+    std::string name; ///< The file name of the module in the bundle.
+    fs::path_t  path; ///< The module file.
+    module_info info; ///< The information the module reports.
+};
+
+/**
+ * @class module_bundle
+ * @brief A read-only container of module images.
+ *
+ * A bundle starts with an index listing, for every member, its name, the
+ * offset and size of its image, its build identifier and its module_info.
+ * The images follow, each starting at a multiple of the alignment recorded
+ * in the header, the page size by default.
+ *
+ * The whole bundle is opened with a single mapping. The images are views
+ * into it, so members are inspected and handed to dynamic_library without
+ * being read into memory first or touching the file system per member.
+ *
+ * @see dynamic_loader::attach_bundle()
+ */
+class module_bundle : private mixin::noncopyable
+{
+public:
+    /**
+     * @brief The default alignment of the member images.
+     */
+    static constexpr std::uint32_t DEFAULT_ALIGNMENT = 4096;
+
+    /**
+     * @brief Returns the path of the bundle file.
+     * @return The path the bundle was opened from.
+     */
+    [[nodiscard]]
+    const fs::path_t &
+    path() const noexcept
+    {
+        return m_path;
+    }
+
+    /**
+     * @brief Returns the members of the bundle.
+     * @return The members in index order.
+     */
+    [[nodiscard]]
+    const std::vector<module_bundle_member> &
+    members() const noexcept
+    {
+        return m_members;
+    }
+
+    /**
+     * @brief Finds a member by name.
+     *
+     * @param name The file name of the module.
+     * @return The member, or nullptr if the bundle does not hold it.
+     */
+    [[nodiscard]]
+    const module_bundle_member *
+    find(std::string_view name) const noexcept;
+
+    /**
+     * @brief Writes a bundle holding the given module files.
+     *
+     * The build identifier of every module is read from its file,
+     * the bundle is replaced with fs::replace_file().
+     *
+     * @param path The path of the bundle file.
+     * @param sources The modules to store, in index order.
+     * @param alignment The alignment of the member images, a power of two.
+     *
+     * @throw fs_error If a module file cannot be read or the bundle written.
+     * @throw dynamic_loader_error If a name is stored twice
+     *                             or the alignment is not a power of two.
+     */
+    static void
+    write(const fs::path_t                     &path,
+          std::span<const module_bundle_source> sources,
+          std::uint32_t                         alignment = DEFAULT_ALIGNMENT);
+
+    /**
+     * @brief Opens a bundle file.
+     *
+     * @param path The path of the bundle file.
+     *
+     * @throw fs_error If the file cannot be mapped.
+     * @throw dynamic_loader_error If the file is not a valid bundle.
+     */
+    explicit module_bundle(fs::path_t path);
+
+private:
+    fs::path_t                        m_path;    ///< The bundle file.
+    fs::mapped_file                   m_file;    ///< The mapping of the bundle.
+    std::vector<module_bundle_member> m_members; ///< The members in index order.
+};
+
+} // namespace mi
+
+#endif /* MI_MODULE_BUNDLE_HPP */
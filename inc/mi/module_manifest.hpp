@@ -0,0 +1,181 @@
+/**
+ * @file module_manifest.hpp
+ * @brief Defines the module_manifest class, a persistent cache of what is
+ *        known about module files, so that unchanged modules need not be
+ *        opened to be described.
+ */
+
+#ifndef MI_MODULE_MANIFEST_HPP
+#define MI_MODULE_MANIFEST_HPP
+
+#include "fs.hpp"
+#include "module_info.hpp"
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mi
+{
+
+/**
+ * @struct file_identity
+ * @brief Identifies the version of a file without reading it.
+ *
+ * A file is considered unchanged as long as it is the same file
+ * of the same size, modified at the same time.
+ */
+struct file_identity
+{
+    std::uint64_t device = 0; ///< The device holding the file.
+    std::uint64_t inode  = 0; ///< The file serial number on the device.
+    std::uint64_t size   = 0; ///< The size in bytes.
+    std::uint64_t mtime  = 0; ///< The modification time in nanoseconds.
+
+    /**
+     * @brief Returns the identity of a file.
+     *
+     * @param path The path of the file.
+     * @return The identity, or std::nullopt if the file cannot be inspected.
+     *
+     * @note The device and inode are zero where the platform does not report them.
+     */
+    [[nodiscard]]
+    static std::optional<file_identity>
+    of(const fs::path_t &path) noexcept;
+
+    /**
+     * @brief Compares two identities.
+     */
+    bool
+    operator==(const file_identity &) const noexcept = default;
+};
+
+/**
+ * @struct module_manifest_entry
+ * @brief Describes a version of a module file.
+ */
+struct module_manifest_entry
+{
+    file_identity            identity; ///< The version of the file described.
+    std::string              build_id; ///< The raw NT_GNU_BUILD_ID, empty if absent.
+    module_info              info;     ///< The information reported by the module.
+    std::vector<std::string> symbols;  ///< The symbols exported by the file.
+};
+
+/**
+ * @class module_manifest
+ * @brief A binary file caching the description of module files.
+ *
+ * The manifest maps module paths to the identity of the file, its build
+ * identifier, the module_info it reported once loaded and the symbols it
+ * exports. The file is mapped and read once on construction. An entry is
+ * only returned while the file it describes is unchanged, so a stale
+ * manifest costs a stat per module but never yields outdated information.
+ *
+ * The manifest is a cache: a missing, truncated or foreign file is treated
+ * as empty and replaced by the next save().
+ *
+ * Lookups and records may be issued concurrently.
+ */
+class module_manifest : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Returns the path of the manifest file.
+     * @return The path the manifest is read from and saved to.
+     */
+    [[nodiscard]]
+    const fs::path_t &
+    path() const noexcept
+    {
+        return m_path;
+    }
+
+    /**
+     * @brief Returns the number of entries.
+     * @return The number of module files described.
+     */
+    [[nodiscard]]
+    std::size_t
+    size() const;
+
+    /**
+     * @brief Checks whether the manifest has entries not saved yet.
+     * @return `true` if save() would write the file, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    is_modified() const;
+
+    /**
+     * @brief Finds the description of a module file.
+     *
+     * @param path The path of the module file.
+     * @return The entry, or nullptr if the file is not described
+     *         or has changed since it was.
+     */
+    [[nodiscard]]
+    std::shared_ptr<const module_manifest_entry>
+    find(const fs::path_t &path) const;
+
+    /**
+     * @brief Describes a module file.
+     *
+     * Does nothing if the file is described and unchanged. Otherwise the
+     * file is inspected for its build identifier and exported symbols and the
+     * entry is replaced. Inspection failures leave these fields empty.
+     *
+     * @param path The path of the module file.
+     * @param info The information reported by the loaded module.
+     */
+    void
+    record(const fs::path_t &path, const module_info &info);
+
+    /**
+     * @brief Writes the manifest file if it was modified.
+     *
+     * The file is replaced with fs::replace_file(),
+     * so readers never observe a partially written manifest.
+     * Entries recorded while the file is written are saved by the next call.
+     *
+     * @throw fs_error If the file cannot be written.
+     */
+    void
+    save();
+
+    /**
+     * @brief Reads the manifest file at the given path, if any.
+     * @param path The path of the manifest file.
+     */
+    explicit module_manifest(fs::path_t path);
+
+private:
+    /**
+     * @brief Parses the contents of a manifest file.
+     *
+     * @param bytes The contents of the file.
+     * @return `true` if the contents are a valid manifest, `false` otherwise.
+     */
+    bool
+    parse(std::span<const std::byte> bytes);
+
+    fs::path_t m_path; ///< The manifest file.
+    std::unordered_map<std::string, std::shared_ptr<const module_manifest_entry>>
+                              m_entries;              ///< Entries by module path.
+    mutable std::shared_mutex m_mutex;                ///< Guards the entries.
+    std::mutex                m_save_mutex;           ///< Serializes save().
+    std::uint64_t             m_generation       = 0; ///< Counts the records.
+    std::uint64_t             m_saved_generation = 0; ///< The generation saved last.
+};
+
+} // namespace mi
+
+#endif /* MI_MODULE_MANIFEST_HPP */
@@ -0,0 +1,157 @@
+/**
+ * @file module_note.hpp
+ * @brief Embeds the module_info of a module in an ELF note
+ *        and reads it back without loading the module.
+ *
+ * A module declares its information once, at namespace scope:
+ *
+ * @code
+ * MI_MODULE_INFO_NOTE("author", "name", "1.0.0", "description");
+ * @endcode
+ *
+ * The record is laid out at compile time in the .note.mi.module_info section,
+ * the host reads it with dl::read_module_info() from the mapped file. No code
+ * of the module runs, so thousands of modules can be listed in milliseconds.
+ */
+
+#ifndef MI_MODULE_NOTE_HPP
+#define MI_MODULE_NOTE_HPP
+
+#include "fs.hpp"
+#include "module_info.hpp"
+#include "os_def.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace mi::note
+{
+
+/**
+ * @brief The owner of the module information note.
+ */
+constexpr char MODULE_INFO_OWNER[] = "MI";
+
+/**
+ * @brief The type of the module information note.
+ */
+constexpr std::uint32_t MODULE_INFO_TYPE = 1;
+
+/**
+ * @brief The layout of the note descriptor, increased on incompatible changes.
+ */
+constexpr std::uint32_t MODULE_INFO_LAYOUT = 1;
+
+/**
+ * @struct module_info_note
+ * @brief An ELF note holding a module_info record.
+ *
+ * The descriptor is the layout version followed by the author, the name,
+ * the version and the description of the module as NUL-terminated strings.
+ *
+ * @tparam Size The size of the strings, including their terminators.
+ */
+template <std::size_t Size>
+struct module_info_note
+{
+    std::uint32_t namesz;                 ///< The size of the owner.
+    std::uint32_t descsz;                 ///< The size of the descriptor.
+    std::uint32_t type;                   ///< MODULE_INFO_TYPE.
+    char          owner[4];               ///< MODULE_INFO_OWNER, padded.
+    std::uint32_t layout;                 ///< MODULE_INFO_LAYOUT.
+    char          strings[(Size + 3) & ~std::size_t(3)]; ///< The strings, padded.
+};
+
+/**
+ * @brief Lays out the module information note at compile time.
+ *
+ * @param author The author of the module.
+ * @param name The name of the module.
+ * @param version The version of the module.
+ * @param description A brief description of the module.
+ *
+ * @return The note, ready to be placed in the note section.
+ */
+template <std::size_t Author, std::size_t Name, std::size_t Version, std::size_t Description>
+consteval module_info_note<Author + Name + Version + Description>
+make_module_info_note(const char (&author)[Author],
+                      const char (&name)[Name],
+                      const char (&version)[Version],
+                      const char (&description)[Description])
+{
+    module_info_note<Author + Name + Version + Description> note{};
+    note.namesz = sizeof(MODULE_INFO_OWNER);
+    note.descsz = sizeof(note.layout) + Author + Name + Version + Description;
+    note.type   = MODULE_INFO_TYPE;
+    note.layout = MODULE_INFO_LAYOUT;
+
+    for (std::size_t index = 0; index < sizeof(MODULE_INFO_OWNER); ++index)
+    {
+        note.owner[index] = MODULE_INFO_OWNER[index];
+    }
+
+    std::size_t offset = 0;
+    for (auto string : {std::span<const char>(author),
+                        std::span<const char>(name),
+                        std::span<const char>(version),
+                        std::span<const char>(description)})
+    {
+        for (auto character : string)
+        {
+            note.strings[offset++] = character;
+        }
+    }
+    return note;
+}
+
+} // namespace mi::note
+
+#ifdef MI_OS_LINUX
+/**
+ * @def MI_MODULE_INFO_NOTE(author, name, version, description)
+ * @brief Embeds the information of a module in its ELF file.
+ *
+ * Expands to a constant placed in the .note.mi.module_info section,
+ * the arguments must be string literals.
+ */
+#    define MI_MODULE_INFO_NOTE(author, name, version, description)                      \
+        [[gnu::used, gnu::section(".note.mi.module_info"), gnu::aligned(4)]]             \
+        static constexpr auto mi_module_info_note =                                      \
+            ::mi::note::make_module_info_note(author, name, version, description)
+#else
+#    define MI_MODULE_INFO_NOTE(author, name, version, description) static_assert(true)
+#endif
+
+namespace mi::dl
+{
+
+/**
+ * @brief Reads the module information note from the image of a module.
+ *
+ * @param bytes The contents of the module file.
+ * @return The information, or std::nullopt if the image is not an ELF file
+ *         of this platform, has no note or a note of an unknown layout.
+ *
+ * @note Notes are read on Linux only, elsewhere std::nullopt is returned.
+ */
+[[nodiscard]]
+std::optional<module_info>
+read_module_info(std::span<const std::byte> bytes) noexcept;
+
+/**
+ * @brief Reads the module information note from a module file.
+ *
+ * The file is mapped read-only and inspected, it is not loaded.
+ *
+ * @param path The path to the module file.
+ * @return The information, or std::nullopt if the file cannot be mapped
+ *         or carries no valid note.
+ */
+[[nodiscard]]
+std::optional<module_info>
+read_module_info(const fs::path_t &path) noexcept;
+
+} // namespace mi::dl
+
+#endif /* MI_MODULE_NOTE_HPP */
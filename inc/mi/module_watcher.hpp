@@ -0,0 +1,121 @@
+/**
+ * @file module_watcher.hpp
+ * @brief Defines the module_watcher class, which reloads dynamic modules
+ *        when their files are replaced.
+ */
+
+#ifndef MI_MODULE_WATCHER_HPP
+#define MI_MODULE_WATCHER_HPP
+
+#include "dynamic_module.hpp"
+#include "exception.hpp"
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mi
+{
+
+/**
+ * @class module_watcher
+ * @brief Watches the files of dynamic modules and reloads modules on change.
+ *
+ * The watcher observes the directories containing the modules with inotify
+ * on a thread of its own. When a module file is written or renamed into
+ * place, the module is reloaded with dynamic_module::reload(), so that the
+ * new version takes over without the module being unloaded.
+ *
+ * Reloads run on the watcher thread, errors are passed to the error handler
+ * and leave the loaded version in place. New versions have to be renamed
+ * into place or written to a new file: a file rewritten in place is still
+ * the loaded version, its reload fails and is reported to the handler.
+ *
+ * @note Modules must not be loaded or unloaded while they are watched,
+ *       since a reload may run at any time.
+ *
+ * @note Watching is supported on Linux only,
+ *       on other platforms watch() throws.
+ */
+class module_watcher : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Starts watching the file of a module.
+     *
+     * Watching the same module more than once has no effect.
+     *
+     * @param module The module to reload when its file changes,
+     *               it must stay alive until it is unwatched.
+     *
+     * @throw dynamic_loader_error If the directory of the module
+     *                             cannot be watched.
+     */
+    void
+    watch(dynamic_module &module);
+
+    /**
+     * @brief Stops watching the file of a module.
+     *
+     * Once the function returns, the module is not reloaded by the watcher
+     * anymore, a reload already in progress is completed first.
+     *
+     * @param module The module to stop watching.
+     */
+    void
+    unwatch(dynamic_module &module) noexcept;
+
+    /**
+     * @brief Starts the watcher thread.
+     *
+     * @param handler Called on the watcher thread with the error of a failed
+     *                reload, errors are ignored if the handler is empty.
+     *
+     * @throw dynamic_loader_error If the watcher cannot be created.
+     */
+    explicit module_watcher(exception::handler_t handler = {});
+
+    /**
+     * @brief Stops and joins the watcher thread.
+     */
+    ~module_watcher() override;
+
+private:
+    /**
+     * @struct entry
+     * @brief A watched module.
+     */
+    struct entry
+    {
+        dynamic_module *module;    ///< The module to reload.
+        int             watch;     ///< The watch of the module directory.
+        fs::path_t      filename;  ///< The file name of the module.
+    };
+
+    /**
+     * @brief The main loop of the watcher thread.
+     */
+    void
+    run();
+
+    /**
+     * @brief Reloads the modules affected by a batch of events.
+     *
+     * @param events The raw inotify events.
+     * @param size The size of the events in bytes.
+     */
+    void
+    dispatch(const char *events, std::size_t size);
+
+    exception::handler_t m_handler;     ///< Receives the errors of reloads.
+    std::vector<entry>   m_entries;     ///< The watched modules.
+    std::mutex           m_mutex;       ///< Guards the entries and reloads.
+    int                  m_notify = -1; ///< The inotify instance.
+    int                  m_wakeup = -1; ///< Signals the thread to stop.
+    std::thread          m_thread;      ///< The watcher thread.
+};
+
+} // namespace mi
+
+#endif /* MI_MODULE_WATCHER_HPP */
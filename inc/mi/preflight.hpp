@@ -0,0 +1,96 @@
+/**
+ * @file preflight.hpp
+ * @brief Declares the pre-flight validation of dynamic libraries,
+ *        performed on the file contents before the library is opened.
+ */
+
+#ifndef MI_PREFLIGHT_HPP
+#define MI_PREFLIGHT_HPP
+
+#include "dynamic_library_error.hpp"
+#include "fs.hpp"
+#include "os_def.hpp"
+#include "result.hpp"
+#include <span>
+#include <string_view>
+
+namespace mi::dl
+{
+
+/**
+ * @brief Validates a dynamic library without loading it.
+ *
+ * The file is mapped read-only and inspected, no code of the library runs
+ * and the process is not otherwise affected. The following is checked:
+ * - the file is an ELF shared object for the machine of the process,
+ * - every required symbol is exported by the library,
+ * - every library listed in DT_NEEDED is either already loaded or can be
+ *   found in the RPATH, LD_LIBRARY_PATH, RUNPATH, the ld.so cache
+ *   or the default library directories.
+ *
+ * @param path The path to the dynamic library.
+ * @param required_symbols The symbols the library must export.
+ *
+ * @throw dynamic_library_error If the library fails any of the checks.
+ *
+ * @note Validation is performed on Linux only, elsewhere it is a no-op.
+ */
+void
+preflight(const fs::path_t &path, std::span<const std::string_view> required_symbols);
+
+/**
+ * @brief Validates the image of a dynamic library held in memory.
+ *
+ * Performs the checks of preflight() on the given bytes instead of
+ * mapping a file.
+ *
+ * @param path The path reported in errors, its directory is substituted
+ *             for $ORIGIN when dependencies are looked up.
+ *
+ * @param bytes The contents of the library.
+ * @param required_symbols The symbols the library must export.
+ *
+ * @throw dynamic_library_error If the library fails any of the checks.
+ *
+ * @note Validation is performed on Linux only, elsewhere it is a no-op.
+ */
+void
+preflight(const fs::path_t                 &path,
+          std::span<const std::byte>        bytes,
+          std::span<const std::string_view> required_symbols);
+
+/**
+ * @brief Validates a dynamic library without loading it or throwing.
+ *
+ * Performs the checks of preflight() and reports the first failing one
+ * as an error, so that probing many candidates costs no exceptions.
+ *
+ * @param path The path to the dynamic library, it must outlive the result.
+ * @param required_symbols The symbols the library must export.
+ *
+ * @return Nothing, or the error the library failed with.
+ */
+[[nodiscard]]
+result<void>
+try_preflight(const fs::path_t &path, std::span<const std::string_view> required_symbols);
+
+/**
+ * @brief Validates the image of a dynamic library held in memory without throwing.
+ *
+ * @param path The path reported in errors, it must outlive the result.
+ * @param bytes The contents of the library.
+ * @param required_symbols The symbols the library must export.
+ *
+ * @return Nothing, or the error the library failed with.
+ *
+ * @see try_preflight()
+ */
+[[nodiscard]]
+result<void>
+try_preflight(const fs::path_t                 &path,
+              std::span<const std::byte>        bytes,
+              std::span<const std::string_view> required_symbols);
+
+} // namespace mi::dl
+
+#endif /* MI_PREFLIGHT_HPP */
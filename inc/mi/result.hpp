@@ -0,0 +1,343 @@
+/**
+ * @file result.hpp
+ * @brief Defines the error and result classes returned by the non-throwing
+ *        functions of the mi::dl namespace.
+ */
+
+#ifndef MI_RESULT_HPP
+#define MI_RESULT_HPP
+
+#include "fs.hpp"
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace mi::dl
+{
+
+/**
+ * @enum errc
+ * @brief Identifies why a dynamic library operation failed.
+ */
+enum class errc : std::uint8_t
+{
+    invalid_extension,       ///< The path lacks the platform library extension.
+    already_loaded,          ///< The library is loaded already.
+    not_loaded,              ///< The library is not loaded.
+    no_read_access,          ///< The file cannot be opened or inspected.
+    not_regular_file,        ///< The path names a directory, a FIFO, etc.
+    empty_file,              ///< The file is empty.
+    empty_image,             ///< The in-memory image is empty.
+    memory_file_failed,      ///< The memory file of an image cannot be created.
+    unsupported,             ///< The operation is not supported on this platform.
+    not_elf,                 ///< The file is not an ELF file.
+    malformed,               ///< The ELF file is malformed.
+    not_loadable,            ///< The file is not a shared object for this machine.
+    missing_symbols,         ///< Required symbols are not exported.
+    unresolved_dependencies, ///< Needed libraries cannot be found.
+    open_failed,             ///< The platform loader failed to open the library.
+    close_failed,            ///< The platform loader failed to close the library.
+    symbol_not_found,        ///< The requested symbol is not exported.
+    modules_failed,          ///< The modules of a loader failed to load.
+};
+
+/**
+ * @brief Returns the description of an error code.
+ *
+ * @param code The error code.
+ * @return A static string describing the code.
+ */
+[[nodiscard]]
+std::string_view
+to_string(errc code) noexcept;
+
+/**
+ * @class error
+ * @brief Describes why a dynamic library operation failed.
+ *
+ * An error is an error code, the path of the library and an optional detail,
+ * such as the name of a symbol or the message of the platform loader.
+ * Building one formats nothing: the message is only composed by message(),
+ * so failures that are merely tested cost no more than the detail string.
+ *
+ * @note The error refers to the path of the library rather than copying it,
+ *       it must not outlive the library or the path it was reported for.
+ */
+class error
+{
+public:
+    /**
+     * @brief Returns the error code.
+     * @return Why the operation failed.
+     */
+    [[nodiscard]]
+    errc
+    code() const noexcept
+    {
+        return m_code;
+    }
+
+    /**
+     * @brief Returns the path of the library the error is about.
+     * @return The path of the library.
+     */
+    [[nodiscard]]
+    const fs::path_t &
+    path() const noexcept
+    {
+        return *m_path;
+    }
+
+    /**
+     * @brief Returns the detail of the error.
+     * @return The detail, empty if the code says it all.
+     */
+    [[nodiscard]]
+    std::string_view
+    detail() const noexcept
+    {
+        return m_detail;
+    }
+
+    /**
+     * @brief Composes the message of the error.
+     * @return The message, as thrown by the throwing functions.
+     */
+    [[nodiscard]]
+    std::string
+    message() const;
+
+    /**
+     * @brief Throws the error as an exception.
+     * @throw dynamic_library_error Always, with message() as its message.
+     */
+    [[noreturn]]
+    void
+    raise() const;
+
+    /**
+     * @brief Constructs an error.
+     *
+     * @param code Why the operation failed.
+     * @param path The path of the library, it must outlive the error.
+     * @param detail The detail of the error.
+     */
+    error(errc code, const fs::path_t &path, std::string detail = {})
+        : m_code(code),
+          m_path(&path),
+          m_detail(std::move(detail))
+    {
+    }
+
+private:
+    errc              m_code;   ///< Why the operation failed.
+    const fs::path_t *m_path;   ///< The path of the library.
+    std::string       m_detail; ///< Symbol names, platform messages, etc.
+};
+
+/**
+ * @class result
+ * @brief Either the value returned by an operation or the error it failed with.
+ *
+ * A minimal counterpart of std::expected, which is not available before C++23.
+ * value() throws the error, so a result can be unwrapped where exceptions
+ * are fine and tested where they are not:
+ *
+ * @code
+ * if (auto loaded = library.try_load(); !loaded)
+ * {
+ *     skipped.push_back(loaded.error().code());
+ * }
+ * @endcode
+ *
+ * @tparam ValueType The type of the value, may be void or an lvalue reference.
+ */
+template <typename ValueType>
+class result
+{
+    /**
+     * @typedef storage_t
+     * @brief The type holding the value, references are held by reference_wrapper.
+     */
+    using storage_t =
+        std::conditional_t<std::is_reference_v<ValueType>,
+                           std::reference_wrapper<std::remove_reference_t<ValueType>>,
+                           ValueType>;
+
+public:
+    /**
+     * @brief Checks whether the result holds a value.
+     * @return `true` if the operation succeeded, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    has_value() const noexcept
+    {
+        return m_state.index() == 0;
+    }
+
+    /**
+     * @brief Checks whether the result holds a value.
+     * @return `true` if the operation succeeded, `false` otherwise.
+     */
+    explicit
+    operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    /**
+     * @brief Returns the value.
+     * @return The value returned by the operation.
+     * @throw dynamic_library_error If the result holds an error.
+     */
+    [[nodiscard]]
+    std::add_lvalue_reference_t<ValueType>
+    value() &
+    {
+        if (!has_value())
+        {
+            error().raise();
+        }
+        return std::get<0>(m_state);
+    }
+
+    /**
+     * @brief Moves the value out of the result.
+     * @return The value returned by the operation.
+     * @throw dynamic_library_error If the result holds an error.
+     */
+    [[nodiscard]]
+    ValueType
+    value() &&
+    {
+        if (!has_value())
+        {
+            error().raise();
+        }
+        return static_cast<ValueType>(std::get<0>(std::move(m_state)));
+    }
+
+    /**
+     * @brief Returns the value without checking for an error.
+     * @return The value returned by the operation.
+     */
+    [[nodiscard]]
+    std::add_lvalue_reference_t<ValueType>
+    operator*() & noexcept
+    {
+        return *std::get_if<0>(&m_state);
+    }
+
+    /**
+     * @brief Returns the error.
+     * @return The error the operation failed with, the result must not hold a value.
+     */
+    [[nodiscard]]
+    const dl::error &
+    error() const noexcept
+    {
+        return *std::get_if<1>(&m_state);
+    }
+
+    /**
+     * @brief Constructs a result holding a value.
+     * @param value The value returned by the operation.
+     */
+    result(ValueType value)
+        : m_state(std::in_place_index<0>, std::forward<ValueType>(value))
+    {
+    }
+
+    /**
+     * @brief Constructs a result holding an error.
+     * @param error The error the operation failed with.
+     */
+    result(dl::error error)
+        : m_state(std::in_place_index<1>, std::move(error))
+    {
+    }
+
+private:
+    std::variant<storage_t, dl::error> m_state; ///< The value or the error.
+};
+
+/**
+ * @class result<void>
+ * @brief The result of an operation returning nothing.
+ */
+template <>
+class result<void>
+{
+public:
+    /**
+     * @brief Checks whether the operation succeeded.
+     * @return `true` if the operation succeeded, `false` otherwise.
+     */
+    [[nodiscard]]
+    bool
+    has_value() const noexcept
+    {
+        return !m_error.has_value();
+    }
+
+    /**
+     * @brief Checks whether the operation succeeded.
+     * @return `true` if the operation succeeded, `false` otherwise.
+     */
+    explicit
+    operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    /**
+     * @brief Checks that the operation succeeded.
+     * @throw dynamic_library_error If the result holds an error.
+     */
+    void
+    value() const
+    {
+        if (m_error.has_value())
+        {
+            m_error->raise();
+        }
+    }
+
+    /**
+     * @brief Returns the error.
+     * @return The error the operation failed with, the result must hold one.
+     */
+    [[nodiscard]]
+    const dl::error &
+    error() const noexcept
+    {
+        return *m_error;
+    }
+
+    /**
+     * @brief Constructs a successful result.
+     */
+    result() noexcept = default;
+
+    /**
+     * @brief Constructs a result holding an error.
+     * @param error The error the operation failed with.
+     */
+    result(dl::error error)
+        : m_error(std::move(error))
+    {
+    }
+
+private:
+    std::optional<dl::error> m_error; ///< The error, if the operation failed.
+};
+
+} // namespace mi::dl
+
+#endif /* MI_RESULT_HPP */
@@ -0,0 +1,175 @@
+/**
+ * @file symbol_cache.hpp
+ * @brief Defines the symbol and symbol_cache classes used by dynamic_library
+ *        to avoid repeated symbol lookups through the platform loader.
+ */
+
+#ifndef MI_SYMBOL_CACHE_HPP
+#define MI_SYMBOL_CACHE_HPP
+
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include "os.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace mi::dl
+{
+
+/**
+ * @class symbol
+ * @brief A symbol name together with its precomputed hash.
+ *
+ * The hash is computed by the constructor, which is constexpr,
+ * so symbols known at compile time carry no hashing cost at the call site:
+ *
+ * @code
+ * constexpr mi::dl::symbol on_tick("on_tick");
+ * library.sym(on_tick);
+ * @endcode
+ *
+ * @note The symbol does not own its name, the referenced characters
+ *       must outlive the symbol.
+ */
+class symbol
+{
+public:
+    /**
+     * @brief Returns the name of the symbol.
+     * @return The name of the symbol.
+     */
+    [[nodiscard]]
+    constexpr std::string_view
+    name() const noexcept
+    {
+        return m_name;
+    }
+
+    /**
+     * @brief Returns the precomputed hash of the symbol name.
+     * @return The 64-bit FNV-1a hash of the name.
+     */
+    [[nodiscard]]
+    constexpr std::uint64_t
+    hash() const noexcept
+    {
+        return m_hash;
+    }
+
+    /**
+     * @brief Constructs a symbol and computes the hash of its name.
+     * @param name The name of the symbol.
+     */
+    constexpr explicit symbol(std::string_view name) noexcept
+        : m_name(name),
+          m_hash(14695981039346656037ULL)
+    {
+        for (const auto character : name)
+        {
+            m_hash ^= static_cast<unsigned char>(character);
+            m_hash *= 1099511628211ULL;
+        }
+    }
+
+private:
+    std::string_view m_name; ///< The name of the symbol.
+    std::uint64_t    m_hash; ///< The hash of the name.
+};
+
+/**
+ * @struct symbol_cache_stats
+ * @brief A snapshot of the counters of a symbol cache.
+ */
+struct symbol_cache_stats
+{
+    std::uint64_t hits;   ///< Lookups answered from the cache.
+    std::uint64_t misses; ///< Lookups forwarded to the platform loader.
+};
+
+/**
+ * @class symbol_cache
+ * @brief A fixed-capacity hash table of resolved symbol addresses.
+ *
+ * Lookups never take a lock: the table is an open-addressing array of atomic
+ * pointers to immutable entries, which are published once and not modified
+ * until the cache is cleared. Insertions are serialized by a mutex.
+ *
+ * When the table is filled up to its load limit, further symbols are
+ * resolved but not cached.
+ *
+ * @warning clear() must not run concurrently with lookups,
+ *          which matches the contract of dynamic_library::unload().
+ */
+class symbol_cache : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief The number of slots in the table, a power of two.
+     */
+    static constexpr std::size_t CAPACITY = 256;
+
+    /**
+     * @brief Looks up a symbol in the cache.
+     *
+     * @param symbol The symbol to look up.
+     * @return The cached address of the symbol, or nullptr if it is not cached.
+     */
+    [[nodiscard]]
+    os::dynamic_library_func_t
+    find(const symbol &symbol) const noexcept;
+
+    /**
+     * @brief Stores the address of a symbol in the cache.
+     *
+     * @param symbol The symbol to store.
+     * @param address The resolved address, null addresses are not stored.
+     */
+    void
+    insert(const symbol &symbol, os::dynamic_library_func_t address);
+
+    /**
+     * @brief Removes all entries from the cache, the counters are kept.
+     */
+    void
+    clear();
+
+    /**
+     * @brief Returns the current values of the hit and miss counters.
+     * @return A snapshot of the counters.
+     */
+    [[nodiscard]]
+    symbol_cache_stats
+    stats() const noexcept;
+
+    /**
+     * @brief Constructs an empty cache.
+     */
+    symbol_cache() = default;
+
+private:
+    /**
+     * @struct entry
+     * @brief An immutable cache entry.
+     */
+    struct entry
+    {
+        std::uint64_t              hash;    ///< The hash of the name.
+        std::string                name;    ///< The name of the symbol.
+        os::dynamic_library_func_t address; ///< The resolved address.
+    };
+
+    std::array<std::atomic<const entry *>, CAPACITY> m_slots{};   ///< The table.
+    std::deque<entry>                                 m_entries;   ///< Entry storage.
+    std::mutex                                        m_mutex;     ///< Serializes writers.
+    mutable std::atomic<std::uint64_t>                m_hits{0};   ///< Hit counter.
+    mutable std::atomic<std::uint64_t>                m_misses{0}; ///< Miss counter.
+};
+
+} // namespace mi::dl
+
+#endif /* MI_SYMBOL_CACHE_HPP */
@@ -0,0 +1,168 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Defines the thread_pool class, a fixed-size pool of worker threads
+ *        executing submitted tasks.
+ */
+
+#ifndef MI_THREAD_POOL_HPP
+#define MI_THREAD_POOL_HPP
+
+#include "exception.hpp"
+#include "executor.hpp"
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mi
+{
+
+/**
+ * @class thread_pool
+ * @brief A fixed-size pool of worker threads.
+ *
+ * Every worker owns a queue. Tasks submitted by a worker are queued to its
+ * own queue, other tasks are spread over the queues, or queued to the worker
+ * named by submit_affine(). Workers run the tasks of their own queue in
+ * submission order and, once it is empty, steal the most recent task from
+ * the queues of the others, so no task waits while a worker is idle.
+ * Every queue has a lock of its own, submitting and taking tasks only
+ * contend with the workers touching the same queue. The pool lock is only
+ * taken to put a worker to sleep, to wake one and by wait().
+ *
+ * The pool is used internally to run independent work, such as module
+ * lifecycle hooks, concurrently, and can serve as the executor of the
+ * asynchronous lifecycle functions.
+ *
+ * @note Exceptions escaping a task are caught by the worker, std::exception
+ *       is passed to the error handler of the pool. Callers needing the
+ *       failure of a task are expected to capture it themselves.
+ */
+class thread_pool : public executor,
+                    private mixin::noncopyable,
+                    private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Returns the number of worker threads in the pool.
+     * @return The number of workers.
+     */
+    [[nodiscard]]
+    std::size_t
+    size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Queues a task for execution by the pool.
+     *
+     * Called from a worker, the task is queued to that worker,
+     * otherwise the queues are used in turn.
+     *
+     * @param task The task to execute.
+     */
+    void
+    submit(task_t task) override;
+
+    /**
+     * @brief Queues a task to a given worker.
+     *
+     * The worker is woken if it is idle. If it is busy, an idle worker is
+     * woken instead and may steal the task.
+     *
+     * @param task The task to execute.
+     * @param affinity The preferred worker, taken modulo size().
+     */
+    void
+    submit_affine(task_t task, std::size_t affinity) override;
+
+    /**
+     * @brief Blocks until the queue is empty and all workers are idle.
+     */
+    void
+    wait();
+
+    /**
+     * @brief Constructs a pool with the given number of workers.
+     *
+     * @param workers The number of worker threads to start.
+     *                A value of zero selects the hardware concurrency.
+     *
+     * @param handler Called on the worker thread with the exception
+     *                escaping a task, exceptions are ignored if it is empty.
+     */
+    explicit thread_pool(std::size_t workers = 0, exception::handler_t handler = {});
+
+    /**
+     * @brief Waits for all queued tasks and joins the workers.
+     */
+    ~thread_pool() override;
+
+private:
+    /**
+     * @struct worker_queue
+     * @brief The tasks queued to a worker.
+     */
+    struct worker_queue
+    {
+        std::mutex              mutex;           ///< Guards the tasks.
+        std::deque<task_t>      tasks;           ///< The queued tasks.
+        std::condition_variable wakeup;          ///< Signals the worker.
+        bool                    waiting = false; ///< Set while the worker sleeps.
+    };
+
+    /**
+     * @brief The main loop of a worker thread.
+     * @param index The index of the worker.
+     */
+    void
+    run(std::size_t index);
+
+    /**
+     * @brief Queues a task to a worker and wakes a worker to run it.
+     *
+     * @param index The index of the worker.
+     * @param task The task to execute.
+     */
+    void
+    push(std::size_t index, task_t task);
+
+    /**
+     * @brief Takes the next task of a worker, stealing one if needed.
+     *
+     * @param index The index of the worker.
+     * @return The task, or an empty function if no task is queued.
+     */
+    task_t
+    take(std::size_t index);
+
+    /**
+     * @brief Runs a task, passing the exception it throws to the handler.
+     * @param task The task to execute.
+     */
+    void
+    execute(task_t &task) noexcept;
+
+    std::size_t                     m_size;            ///< The number of workers.
+    std::vector<std::thread>        m_workers;         ///< The worker threads.
+    std::unique_ptr<worker_queue[]> m_queues;          ///< The queue of every worker.
+    exception::handler_t            m_handler;         ///< Receives the task failures.
+    std::mutex                      m_mutex;           ///< Guards sleeping and stopping.
+    std::condition_variable         m_idle;            ///< Signals waiters about an idle pool.
+    std::atomic<std::size_t>        m_pending{0};      ///< Tasks queued or being executed.
+    std::atomic<std::size_t>        m_queued{0};       ///< Tasks queued, not taken yet.
+    std::atomic<std::size_t>        m_sleeping{0};     ///< Workers sleeping.
+    std::atomic<std::size_t>        m_next{0};         ///< The queue of the next task.
+    bool                            m_stopped = false; ///< Set when the pool is shutting down.
+};
+
+} // namespace mi
+
+#endif /* MI_THREAD_POOL_HPP */
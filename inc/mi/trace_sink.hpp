@@ -0,0 +1,152 @@
+/**
+ * @file trace_sink.hpp
+ * @brief Defines the trace_sink interface receiving lifecycle trace events
+ *        and the trace_scope class emitting them.
+ */
+
+#ifndef MI_TRACE_SINK_HPP
+#define MI_TRACE_SINK_HPP
+
+#include "fs.hpp"
+#include "noncopyable.hpp"
+#include "nonmovable.hpp"
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <thread>
+
+namespace mi::trace
+{
+
+/**
+ * @struct trace_event
+ * @brief Describes the beginning or the end of a traced operation.
+ */
+struct trace_event
+{
+    std::string_view                      name;   ///< The traced operation.
+    const fs::path_t                     &path;   ///< The library it operates on.
+    std::thread::id                       thread; ///< The thread running it.
+    std::chrono::steady_clock::time_point time;   ///< When the event occurred.
+};
+
+/**
+ * @class trace_sink
+ * @brief Abstract receiver of the trace events emitted by the library.
+ *
+ * Loading and unloading of libraries and modules, the open of a library by
+ * the platform loader ("dlopen"), their lifecycle hooks and the loading of
+ * attached modules are traced. Every operation emits a begin
+ * event and an end event on the thread that runs it, so events of different
+ * threads interleave and sinks have to be thread-safe.
+ *
+ * No events are emitted until a sink is installed with install(). Without
+ * a sink, tracing an operation costs a single branch.
+ */
+class trace_sink : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Returns the installed sink.
+     * @return The sink receiving the events, or nullptr if tracing is off.
+     */
+    [[nodiscard]]
+    static trace_sink *
+    installed() noexcept
+    {
+        return s_installed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Installs the sink receiving the events.
+     *
+     * @param sink The sink to install, or nullptr to turn tracing off.
+     *             It must stay alive until operations traced while
+     *             it was installed have ended.
+     *
+     * @return The previously installed sink, or nullptr.
+     */
+    static trace_sink *
+    install(trace_sink *sink) noexcept
+    {
+        return s_installed.exchange(sink, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Receives the beginning of an operation.
+     * @param event The event to record.
+     */
+    virtual void
+    begin(const trace_event &event) = 0;
+
+    /**
+     * @brief Receives the end of an operation.
+     * @param event The event to record.
+     */
+    virtual void
+    end(const trace_event &event) = 0;
+
+    /**
+     * @brief Destroys the trace sink.
+     */
+    ~trace_sink() override = default;
+
+private:
+    static inline std::atomic<trace_sink *> s_installed{nullptr}; ///< Active sink.
+};
+
+/**
+ * @class trace_scope
+ * @brief Traces the operation running during its lifetime.
+ *
+ * The begin event is emitted on construction and the end event on
+ * destruction, both to the sink installed at construction. Exceptions
+ * thrown by the sink are discarded, tracing never fails an operation.
+ */
+class trace_scope : private mixin::noncopyable, private mixin::nonmovable
+{
+public:
+    /**
+     * @brief Begins tracing an operation.
+     *
+     * @param name The name of the operation, it must outlive the scope.
+     * @param path The library the operation works on, it must outlive the scope.
+     */
+    trace_scope(std::string_view name, const fs::path_t &path) noexcept
+        : m_sink(trace_sink::installed()),
+          m_name(name),
+          m_path(path)
+    {
+        if (m_sink != nullptr)
+        {
+            emit(&trace_sink::begin);
+        }
+    }
+
+    /**
+     * @brief Ends tracing the operation.
+     */
+    ~trace_scope() override
+    {
+        if (m_sink != nullptr)
+        {
+            emit(&trace_sink::end);
+        }
+    }
+
+private:
+    /**
+     * @brief Passes an event stamped with the current thread and time to the sink.
+     * @param receiver The member of the sink receiving the event.
+     */
+    void
+    emit(void (trace_sink::*receiver)(const trace_event &)) noexcept;
+
+    trace_sink       *m_sink; ///< The sink receiving the events.
+    std::string_view  m_name; ///< The traced operation.
+    const fs::path_t &m_path; ///< The library it operates on.
+};
+
+} // namespace mi::trace
+
+#endif /* MI_TRACE_SINK_HPP */
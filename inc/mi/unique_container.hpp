@@ -193,7 +193,7 @@ protected:
     {
         if (is_value_null(index))
         {
-            throw null_pointer_error("no value assigned (index: {})", index);
+            throw exception::null_pointer_error("no value assigned (index: {})", index);
         }
     }
 
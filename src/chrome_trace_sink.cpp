@@ -0,0 +1,86 @@
+#include <mi/chrome_trace_sink.hpp>
+#include <mi/os.hpp>
+#include <string>
+
+using namespace mi;
+using namespace mi::trace;
+
+namespace
+{
+
+/**
+ * @brief Writes a string as a JSON string literal.
+ */
+void
+write_json_string(std::ostream &stream, std::string_view string)
+{
+    constexpr char HEX[] = "0123456789abcdef";
+
+    stream.put('"');
+    for (const char character : string)
+    {
+        const auto code = static_cast<unsigned char>(character);
+        if (character == '"' || character == '\\')
+        {
+            stream.put('\\').put(character);
+        }
+        else if (code < 0x20)
+        {
+            stream << "\\u00" << HEX[code >> 4] << HEX[code & 0x0f];
+        }
+        else
+        {
+            stream.put(character);
+        }
+    }
+    stream.put('"');
+}
+
+} // namespace
+
+void
+chrome_trace_sink::begin(const trace_event &event)
+{
+    write("B", event);
+}
+
+void
+chrome_trace_sink::end(const trace_event &event)
+{
+    write("E", event);
+}
+
+void
+chrome_trace_sink::write(std::string_view phase, const trace_event &event)
+{
+    const auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+        event.time - m_origin);
+    const auto path = event.path.u8string();
+
+    std::lock_guard lock(m_mutex);
+    const auto thread = m_threads.try_emplace(event.thread, m_threads.size() + 1)
+                            .first->second;
+
+    m_stream << (m_empty ? "[\n" : ",\n") << "{\"name\":";
+    write_json_string(m_stream, event.name);
+    m_stream << ",\"cat\":\"mi\",\"ph\":\"" << phase << "\",\"ts\":" << time.count()
+             << ",\"pid\":" << os::current_process_id() << ",\"tid\":" << thread
+             << ",\"args\":{\"path\":";
+    write_json_string(m_stream,
+                      std::string_view(reinterpret_cast<const char *>(path.data()),
+                                       path.size()));
+    m_stream << "}}";
+    m_empty = false;
+}
+
+chrome_trace_sink::chrome_trace_sink(std::ostream &stream)
+    : m_stream(stream),
+      m_origin(std::chrono::steady_clock::now())
+{
+}
+
+chrome_trace_sink::~chrome_trace_sink()
+{
+    m_stream << (m_empty ? "[]\n" : "\n]\n");
+    m_stream.flush();
+}
@@ -1,13 +1,232 @@
+#include <algorithm>
+#include <mi/bitflag.hpp>
 #include <mi/dynamic_library.hpp>
+#include <mi/preflight.hpp>
+#include <mi/trace_sink.hpp>
+#include <mutex>
+#include <unordered_map>
 
 #ifdef MI_OS_UNIX_LIKE
 #    include <dlfcn.h>
+#    include <fcntl.h>
 #    include <mi/str.hpp>
+#    include <string>
+#    include <unistd.h>
+#endif
+
+#ifdef MI_OS_LINUX
+#    include <cerrno>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
 #endif
 
 using namespace mi;
 using namespace mi::dl;
 
+/**
+ * @struct mi::dl::shared_handle
+ * @brief A handle shared by the libraries opened with LOAD_POLICY_SHARED_FLAG.
+ *
+ * Guarded by the loader mutex, like the registry holding it.
+ */
+struct dl::shared_handle
+{
+    std::string                  key;               ///< The key in the registry.
+    os::dynamic_library_handle_t handle     = nullptr; ///< The opened library.
+    int                          descriptor = -1;      ///< The file it was opened from.
+    std::size_t                  references = 0;       ///< The libraries using it.
+    symbol_cache                 symbols;              ///< Shared resolved symbols.
+};
+
+namespace
+{
+
+/**
+ * @brief Returns the mutex serializing calls into the platform loader.
+ *
+ * Opening and closing libraries runs static constructors and destructors
+ * and mutates the global list of loaded objects, so these calls are never
+ * issued concurrently, even when modules are loaded in parallel. The mutex
+ * is recursive since static constructors may load further libraries.
+ */
+std::recursive_mutex &
+loader_mutex()
+{
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+#ifdef MI_OS_UNIX_LIKE
+
+/**
+ * @brief Translates load policy flags into a dlopen mode.
+ */
+int
+native_mode(load_policy_flags policy) noexcept
+{
+    int mode = BITFLAG_CHECK(policy, LOAD_POLICY_NOW_FLAG) ? RTLD_NOW : RTLD_LAZY;
+    mode |= BITFLAG_CHECK(policy, LOAD_POLICY_GLOBAL_FLAG) ? RTLD_GLOBAL : RTLD_LOCAL;
+
+    if (BITFLAG_CHECK(policy, LOAD_POLICY_NODELETE_FLAG))
+    {
+        mode |= RTLD_NODELETE;
+    }
+
+#    ifdef RTLD_DEEPBIND
+    if (BITFLAG_CHECK(policy, LOAD_POLICY_DEEPBIND_FLAG))
+    {
+        mode |= RTLD_DEEPBIND;
+    }
+#    endif
+    return mode;
+}
+
+#endif
+
+/**
+ * @brief Returns the registry of shared handles, guarded by the loader mutex.
+ */
+std::unordered_map<std::string, std::shared_ptr<shared_handle>> &
+shared_handles()
+{
+    static std::unordered_map<std::string, std::shared_ptr<shared_handle>> handles;
+    return handles;
+}
+
+/**
+ * @brief Closes a library through the platform loader.
+ * @return `true` on success, `false` otherwise.
+ */
+bool
+close_handle(os::dynamic_library_handle_t handle) noexcept
+{
+#ifdef MI_OS_UNIX_LIKE
+    return dlclose(handle) == 0;
+#else
+    return FreeLibrary(handle) != 0;
+#endif
+}
+
+/**
+ * @brief Closes the file a reloaded version was opened from, if any.
+ */
+void
+close_descriptor(int &descriptor) noexcept
+{
+#ifdef MI_OS_UNIX_LIKE
+    if (descriptor >= 0)
+    {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+#endif
+}
+
+#ifdef MI_OS_LINUX
+
+/**
+ * @brief Opens the file of a library and checks it in one statx call.
+ *
+ * The file is opened without blocking, so that a FIFO found at the path
+ * is reported instead of waiting for a writer.
+ *
+ * @param path The path of the library.
+ * @param key Receives the key of the file in the registry of shared handles,
+ *            derived from its device and inode, if not null.
+ *
+ * @return The descriptor of the file, owned by the caller, or the error
+ *         if the file cannot be opened for reading, is not a regular file
+ *         or is empty.
+ */
+result<int>
+open_library(const fs::path_t &path, std::string *key = nullptr)
+{
+    int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+    if (descriptor < 0)
+    {
+        return error(errc::no_read_access, path, os::last_error_message());
+    }
+
+    struct statx status{};
+    if (::statx(descriptor,
+                "",
+                AT_EMPTY_PATH,
+                STATX_TYPE | STATX_SIZE | STATX_INO,
+                &status) != 0)
+    {
+        auto message = os::last_error_message();
+        close_descriptor(descriptor);
+        return error(errc::no_read_access, path, std::move(message));
+    }
+    else if (!S_ISREG(status.stx_mode))
+    {
+        close_descriptor(descriptor);
+        return error(errc::not_regular_file, path);
+    }
+    else if (status.stx_size == 0)
+    {
+        close_descriptor(descriptor);
+        return error(errc::empty_file, path);
+    }
+
+    if (key != nullptr)
+    {
+        *key = "file:" + std::to_string(status.stx_dev_major) + ":" +
+               std::to_string(status.stx_dev_minor) + ":" +
+               std::to_string(status.stx_ino);
+    }
+    return descriptor;
+}
+
+/**
+ * @brief Copies the image of a library into a sealed anonymous memory file.
+ *
+ * @return The descriptor of the memory file, owned by the caller,
+ *         or the error if the memory file cannot be created or written.
+ */
+result<int>
+open_image(const fs::path_t &path, std::span<const std::byte> image)
+{
+    if (image.empty())
+    {
+        return error(errc::empty_image, path);
+    }
+
+    int descriptor =
+        ::memfd_create(path.filename().c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (descriptor < 0)
+    {
+        return error(errc::memory_file_failed, path, os::last_error_message());
+    }
+
+    for (std::size_t offset = 0; offset < image.size();)
+    {
+        const auto written =
+            ::write(descriptor, image.data() + offset, image.size() - offset);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (written <= 0)
+        {
+            auto message = os::last_error_message();
+            close_descriptor(descriptor);
+            return error(errc::memory_file_failed, path, std::move(message));
+        }
+        offset += static_cast<std::size_t>(written);
+    }
+
+    /// The sealed file can no longer change under the mapping of the library.
+    ::fcntl(descriptor,
+            F_ADD_SEALS,
+            F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+    return descriptor;
+}
+
+#endif
+
+} // namespace
+
 bool
 dynamic_library::is_unloaded() const noexcept
 {
@@ -22,69 +241,290 @@ dynamic_library::is_loaded() const noexcept
 
 os::dynamic_library_func_t
 dynamic_library::sym_unsafe(std::string_view name) const
+{
+    return sym_unsafe(m_handle.load(std::memory_order_acquire), name);
+}
+
+os::dynamic_library_func_t
+dynamic_library::sym_unsafe(os::dynamic_library_handle_t handle,
+                            std::string_view             name) noexcept
 {
 #ifdef MI_OS_UNIX_LIKE
-    return dlsym(m_handle, name.data());
+    return dlsym(handle, name.data());
 #else
-    return GetProcAddress(m_handle, name.data());
+    return GetProcAddress(handle, name.data());
 #endif
 }
 
-os::dynamic_library_func_t
-dynamic_library::sym(std::string_view name) const
+result<os::dynamic_library_func_t>
+dynamic_library::lookup(const symbol &symbol) const
 {
     if (is_unloaded())
     {
-        throw exception::dynamic_library_error(
-            "failed to get symbol, dynamic library is not loaded "
-            "(symbol: {}, path: {})",
-            name,
-            m_path);
+        return error(errc::not_loaded, m_path, std::string(symbol.name()));
     }
-    return sym_unsafe(name);
+    else if (auto address = m_cache->find(symbol))
+    {
+        return address;
+    }
+
+    auto address = sym_unsafe(symbol.name());
+    m_cache->insert(symbol, address);
+    return address;
 }
 
 void
 dynamic_library::load()
 {
-    if (!fs::is_readable(m_path))
+    try_load().value();
+}
+
+result<void>
+dynamic_library::try_load()
+{
+    trace::trace_scope scope("dynamic_library::load", m_path);
+    if (m_image.empty() && path().extension() != os::DYNAMIC_LIBRARY_EXTENSION)
     {
-        throw exception::dynamic_library_error("no read access (path: {})", m_path);
+        return error(errc::invalid_extension, m_path);
     }
-    else if (path().extension() != os::DYNAMIC_LIBRARY_EXTENSION)
+    else if (is_loaded())
     {
-        throw exception::dynamic_library_error("invalid extension (path: {})", m_path);
+        return error(errc::already_loaded, m_path);
     }
-    else if (is_loaded())
+
+    int         descriptor = -1;
+    std::string key;
+    const bool  shared     = BITFLAG_CHECK(m_policy, LOAD_POLICY_SHARED_FLAG);
+    if (!m_image.empty())
     {
-        throw exception::dynamic_library_error("already loaded (path: {})", m_path);
+#ifdef MI_OS_LINUX
+        /// An image is identified by its range, which must stay unchanged anyway.
+        if (shared)
+        {
+            key = "image:" +
+                  std::to_string(reinterpret_cast<std::uintptr_t>(m_image.data())) +
+                  ":" + std::to_string(m_image.size());
+            if (join_shared(key))
+            {
+                return resolve_tables();
+            }
+        }
+
+        if (m_preflight)
+        {
+            if (auto valid = dl::try_preflight(m_path, m_image, required_symbols());
+                !valid)
+            {
+                return valid;
+            }
+        }
+
+        auto opened = open_image(m_path, m_image);
+        if (!opened)
+        {
+            return opened.error();
+        }
+        descriptor = *opened;
+#else
+        return error(errc::unsupported, m_path, "in-memory libraries");
+#endif
     }
+    else
+    {
+#ifdef MI_OS_LINUX
+        /// The file is checked on an open descriptor instead of by path,
+        /// which takes a single statx and no extra path walk.
+        auto opened = open_library(m_path, shared ? &key : nullptr);
+        if (!opened)
+        {
+            return opened.error();
+        }
+        descriptor = *opened;
 
-#ifdef MI_OS_UNIX_LIKE
-    m_handle = dlopen(m_path.c_str(), RTLD_LAZY);
+        /// Another library opened the same file, it was validated then.
+        if (shared && join_shared(key))
+        {
+            close_descriptor(descriptor);
+            return resolve_tables();
+        }
+#else
+        if (!fs::is_readable(m_path))
+        {
+            return error(errc::no_read_access, m_path);
+        }
+#endif
+
+        if (m_preflight)
+        {
+            if (auto valid = dl::try_preflight(m_path, required_symbols()); !valid)
+            {
+                close_descriptor(descriptor);
+                return valid;
+            }
+        }
+    }
+
+    /// In-memory libraries have no path to be opened by.
+    const bool by_descriptor =
+        !m_image.empty() || BITFLAG_CHECK(m_policy, LOAD_POLICY_DESCRIPTOR_FLAG);
+
+    {
+        std::lock_guard    lock(loader_mutex());
+        trace::trace_scope binding("dlopen", m_path);
+        const auto         start = std::chrono::steady_clock::now();
+#ifdef MI_OS_LINUX
+        if (by_descriptor)
+        {
+            const auto name = "/proc/self/fd/" + std::to_string(descriptor);
+            m_handle        = dlopen(name.c_str(), native_mode(m_policy));
+        }
+        else
+        {
+            m_handle = dlopen(m_path.c_str(), native_mode(m_policy));
+        }
+#elif defined(MI_OS_UNIX_LIKE)
+        m_handle = dlopen(m_path.c_str(), native_mode(m_policy));
 #elif defined(MI_OS_WINDOWS)
-    m_handle = LoadLibraryW(m_path.c_str());
+        m_handle = LoadLibraryW(m_path.c_str());
 #endif
+        m_load_duration = std::chrono::steady_clock::now() - start;
+    }
+
+    /// A library opened through its descriptor keeps it open while loaded,
+    /// which keeps its name unique, like a reloaded version.
+    if (is_loaded() && shared && !key.empty())
+    {
+        publish_shared(key, by_descriptor ? descriptor : -1);
+        if (!by_descriptor)
+        {
+            close_descriptor(descriptor);
+        }
+    }
+    else if (is_loaded() && by_descriptor)
+    {
+        m_descriptor = descriptor;
+    }
+    else
+    {
+        close_descriptor(descriptor);
+    }
 
     if (is_unloaded())
     {
-        throw exception::dynamic_library_error(last_error_message());
+        return error(errc::open_failed, m_path, last_error_message());
+    }
+    return resolve_tables();
+}
+
+result<void>
+dynamic_library::resolve_tables()
+{
+    std::string missing;
+    for (auto *table : m_tables)
+    {
+        auto names = resolve(*table);
+        if (!names.empty())
+        {
+            missing += missing.empty() ? names : ", " + names;
+        }
+    }
+
+    if (!missing.empty())
+    {
+        /// A library left loaded is reported instead of the missing symbols.
+        try
+        {
+            dynamic_library::unload();
+        }
+        catch (const exception::dynamic_library_error &closing)
+        {
+            return error(errc::close_failed, m_path, closing.what());
+        }
+        return error(errc::missing_symbols, m_path, std::move(missing));
+    }
+    return {};
+}
+
+bool
+dynamic_library::join_shared(const std::string &key)
+{
+    std::lock_guard lock(loader_mutex());
+    const auto     &handles = shared_handles();
+    if (auto found = handles.find(key); found != handles.end())
+    {
+        m_shared = found->second;
+        ++m_shared->references;
+        m_cache         = &m_shared->symbols;
+        m_load_duration = {};
+        m_handle.store(m_shared->handle, std::memory_order_release);
+        return true;
     }
+    return false;
+}
+
+void
+dynamic_library::publish_shared(const std::string &key, int descriptor)
+{
+    std::lock_guard lock(loader_mutex());
+    auto           &slot = shared_handles()[key];
+    if (slot != nullptr)
+    {
+        /// The same file was opened concurrently by another library,
+        /// its handle is joined and the extra reference dropped.
+        close_handle(m_handle.exchange(slot->handle, std::memory_order_acq_rel));
+        close_descriptor(descriptor);
+    }
+    else
+    {
+        slot             = std::make_shared<shared_handle>();
+        slot->key        = key;
+        slot->handle     = m_handle.load(std::memory_order_relaxed);
+        slot->descriptor = descriptor;
+    }
+
+    m_shared = slot;
+    ++m_shared->references;
+    m_cache = &m_shared->symbols;
+}
+
+bool
+dynamic_library::release_shared() noexcept
+{
+    if (m_shared->references > 1)
+    {
+        --m_shared->references;
+        return true;
+    }
+    else if (!close_handle(m_shared->handle))
+    {
+        return false;
+    }
+
+    close_descriptor(m_shared->descriptor);
+    shared_handles().erase(m_shared->key);
+    m_shared->references = 0;
+    return true;
 }
 
 void
 dynamic_library::unload()
 {
+    trace::trace_scope scope("dynamic_library::unload", m_path);
+    m_pending.store(false, std::memory_order_release);
     if (is_loaded())
     {
-#ifdef MI_OS_UNIX_LIKE
-        if (!dlclose(m_handle))
+        std::lock_guard lock(loader_mutex());
+        if (m_shared != nullptr ? release_shared() : close_handle(m_handle))
         {
-#else
-        if (FreeLibrary(m_handle))
-        {
-#endif
             m_handle = nullptr;
+            m_shared = nullptr;
+            m_cache  = &m_symbols;
+            m_symbols.clear();
+            close_descriptor(m_descriptor);
+            for (auto *table : m_tables)
+            {
+                table->reset();
+            }
         }
     }
 
@@ -94,12 +534,292 @@ dynamic_library::unload()
     }
 }
 
+void
+dynamic_library::reload()
+{
+    if (is_unloaded())
+    {
+        throw exception::dynamic_library_error("failed to reload, not loaded (path: {})",
+                                               m_path);
+    }
+    else if (!m_image.empty())
+    {
+        throw exception::dynamic_library_error(
+            "failed to reload, loaded from memory (path: {})",
+            m_path);
+    }
+    else if (is_shared())
+    {
+        throw exception::dynamic_library_error(
+            "failed to reload, the handle is shared (path: {})",
+            m_path);
+    }
+    else if (m_preflight)
+    {
+        dl::preflight(m_path, required_symbols());
+    }
+
+#ifdef MI_OS_LINUX
+    /// The platform loader identifies libraries by name first, so the new
+    /// version is opened through its descriptor. The descriptor stays open
+    /// while the version is loaded, which keeps the name unique.
+    int descriptor = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+    {
+        throw exception::dynamic_library_error(
+            "failed to reload, cannot open file (path: {}, error: {})",
+            m_path,
+            os::last_error_message());
+    }
+
+    os::dynamic_library_handle_t next = nullptr;
+    {
+        const auto         name = "/proc/self/fd/" + std::to_string(descriptor);
+        std::lock_guard    lock(loader_mutex());
+        trace::trace_scope binding("dlopen", m_path);
+        const auto         start = std::chrono::steady_clock::now();
+        next                     = dlopen(name.c_str(), native_mode(m_policy));
+        m_load_duration          = std::chrono::steady_clock::now() - start;
+    }
+
+    if (next == nullptr)
+    {
+        const auto message = last_error_message();
+        close_descriptor(descriptor);
+        throw exception::dynamic_library_error("failed to reload, {} (path: {})",
+                                               message,
+                                               m_path);
+    }
+
+    auto close = [this](os::dynamic_library_handle_t handle, int descriptor)
+    {
+        std::lock_guard lock(loader_mutex());
+        dlclose(handle);
+        close_descriptor(descriptor);
+    };
+
+    /// The same file yields the loaded version itself: it was not replaced,
+    /// or it was rewritten in place, which the loaded version cannot see.
+    if (next == m_handle.load(std::memory_order_acquire))
+    {
+        close(next, descriptor);
+        throw exception::dynamic_library_error(
+            "failed to reload, the file is the loaded version (path: {})",
+            m_path);
+    }
+
+    std::string missing;
+    for (const auto *table : m_tables)
+    {
+        for (const auto *binding : table->bindings())
+        {
+            if (binding->is_required() &&
+                sym_unsafe(next, binding->symbol().name()) == nullptr)
+            {
+                missing += missing.empty() ? "" : ", ";
+                missing += binding->symbol().name();
+            }
+        }
+    }
+
+    if (!missing.empty())
+    {
+        close(next, descriptor);
+        throw exception::dynamic_library_error(
+            "failed to reload, missing required symbols (symbols: {}, path: {})",
+            missing,
+            m_path);
+    }
+
+    os::dynamic_library_handle_t previous            = nullptr;
+    int                          previous_descriptor = -1;
+    {
+        /// Holds new pins back and waits for pinned callers to return.
+        std::lock_guard lock(m_swap);
+        m_swapping.store(true, std::memory_order_seq_cst);
+        for (auto readers = m_readers.load(std::memory_order_seq_cst); readers != 0;
+             readers      = m_readers.load(std::memory_order_seq_cst))
+        {
+            m_readers.wait(readers, std::memory_order_seq_cst);
+        }
+        m_swapper.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        exception::invoke_noexcept(&dynamic_library::before_reload,
+                                   this,
+                                   m_handle.load(std::memory_order_relaxed),
+                                   next);
+
+        previous            = m_handle.exchange(next, std::memory_order_acq_rel);
+        previous_descriptor = std::exchange(m_descriptor, descriptor);
+        m_symbols.clear();
+        for (auto *table : m_tables)
+        {
+            resolve(*table);
+        }
+
+        exception::invoke_noexcept(&dynamic_library::after_reload, this, previous);
+        m_swapper.store(std::thread::id(), std::memory_order_relaxed);
+        m_swapping.store(false, std::memory_order_seq_cst);
+        m_swapping.notify_all();
+    }
+
+    close(previous, previous_descriptor);
+#else
+    throw exception::dynamic_library_error(
+        "hot reload is not supported on this platform (path: {})",
+        m_path);
+#endif
+}
+
+result<void>
+dynamic_library::load_pending() const
+{
+    std::lock_guard lock(m_activation);
+    if (m_activating || !is_pending())
+    {
+        return {};
+    }
+
+    /// The library stays pending while it is loaded, so that other users wait
+    /// here until the load hooks have run rather than finding it half ready.
+    m_activating = true;
+    try
+    {
+        auto loaded = const_cast<dynamic_library *>(this)->try_load();
+        m_activating = false;
+        m_pending.store(false, std::memory_order_release);
+        return loaded;
+    }
+    catch (...)
+    {
+        m_activating = false;
+        m_pending.store(false, std::memory_order_release);
+        throw;
+    }
+}
+
+dynamic_library::pin_guard::pin_guard(const dynamic_library *library) noexcept
+    : m_library(library)
+{
+    if (m_library == nullptr)
+    {
+        return;
+    }
+
+    bool nested = false;
+    for (const auto *pin = t_pins; pin != nullptr && !nested; pin = pin->m_next)
+    {
+        nested = pin->m_library == m_library;
+    }
+    m_next = std::exchange(t_pins, this);
+
+    /// A nested pin must not wait, the swap waits for the outer one.
+    m_library->m_readers.fetch_add(1, std::memory_order_seq_cst);
+    while (!nested && m_library->m_swapping.load(std::memory_order_seq_cst))
+    {
+        if (m_library->m_readers.fetch_sub(1, std::memory_order_seq_cst) == 1)
+        {
+            m_library->m_readers.notify_all();
+        }
+        m_library->m_swapping.wait(true, std::memory_order_seq_cst);
+        m_library->m_readers.fetch_add(1, std::memory_order_seq_cst);
+    }
+}
+
+dynamic_library::pin_guard::~pin_guard()
+{
+    if (m_library == nullptr)
+    {
+        return;
+    }
+
+    /// Pins are usually released in reverse order, the list is walked otherwise.
+    auto **link = &t_pins;
+    while (*link != this)
+    {
+        link = &(*link)->m_next;
+    }
+    *link = m_next;
+
+    if (m_library->m_readers.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+        m_library->m_swapping.load(std::memory_order_seq_cst))
+    {
+        m_library->m_readers.notify_all();
+    }
+}
+
+void
+dynamic_library::before_reload(os::dynamic_library_handle_t, os::dynamic_library_handle_t)
+{
+}
+
+void
+dynamic_library::after_reload(os::dynamic_library_handle_t)
+{
+}
+
+void
+dynamic_library::bind(interface_table &table)
+{
+    if (std::find(m_tables.begin(), m_tables.end(), &table) != m_tables.end())
+    {
+        return;
+    }
+
+    if (is_loaded())
+    {
+        if (auto missing = resolve(table); !missing.empty())
+        {
+            table.reset();
+            throw exception::dynamic_library_error(
+                "missing required symbols (symbols: {}, path: {})",
+                missing,
+                m_path);
+        }
+    }
+    m_tables.push_back(&table);
+}
+
+void
+dynamic_library::unbind(interface_table &table) noexcept
+{
+    if (auto found = std::find(m_tables.begin(), m_tables.end(), &table);
+        found != m_tables.end())
+    {
+        m_tables.erase(found);
+        table.reset();
+    }
+}
+
+std::string
+dynamic_library::resolve(interface_table &table) const
+{
+    std::string missing;
+    for (auto *binding : table.bindings())
+    {
+        binding->assign(sym_unsafe(binding->symbol().name()));
+        if (binding->is_required() && !binding->is_bound())
+        {
+            missing += missing.empty() ? "" : ", ";
+            missing += binding->symbol().name();
+        }
+    }
+    return missing;
+}
+
 dynamic_library::dynamic_library(fs::path_t path)
     : m_path(std::move(path)),
       m_handle(nullptr)
 {
 }
 
+dynamic_library::dynamic_library(fs::path_t path, std::span<const std::byte> image)
+    : m_path(std::move(path)),
+      m_image(image),
+      m_handle(nullptr)
+{
+}
+
 dynamic_library::~dynamic_library()
 {
     exception::invoke_noexcept(&dynamic_library::unload, this);
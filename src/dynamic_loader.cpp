@@ -1,44 +1,457 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <mi/dynamic_loader.hpp>
+#include <mi/os.hpp>
+#include <mi/preflight.hpp>
+#include <mi/thread_pool.hpp>
+#include <mi/trace_sink.hpp>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
 
 using namespace mi;
 
+namespace
+{
+
+/**
+ * @struct module_graph
+ * @brief The dependency graph of the attached modules.
+ *
+ * Edges point from a module to the modules that may be processed once it is
+ * processed, i.e. to its dependents when loading and to its dependencies
+ * when unloading.
+ */
+struct module_graph
+{
+    std::vector<dynamic_module *>         nodes;   ///< Modules in attach order.
+    std::vector<std::vector<std::size_t>> edges;   ///< Outgoing edges per module.
+    std::vector<std::size_t>              degrees; ///< Incoming edges per module.
+    std::vector<std::size_t>              order;   ///< Topological order.
+};
+
+module_graph
+make_module_graph(const base_loader<dynamic_module> &loader, bool reverse)
+{
+    module_graph                                       graph;
+    std::unordered_map<dynamic_module *, std::size_t> indices;
+
+    for (const auto &module : loader)
+    {
+        if (module != nullptr)
+        {
+            indices.emplace(module.get(), graph.nodes.size());
+            graph.nodes.push_back(module.get());
+        }
+    }
+
+    graph.edges.resize(graph.nodes.size());
+    graph.degrees.resize(graph.nodes.size());
+
+    for (std::size_t index = 0; index < graph.nodes.size(); ++index)
+    {
+        for (auto *dependency : graph.nodes[index]->dependencies())
+        {
+            /// Dependencies attached elsewhere are not managed by this loader.
+            if (auto found = indices.find(dependency); found != indices.end())
+            {
+                const auto from = reverse ? index : found->second;
+                const auto to   = reverse ? found->second : index;
+                graph.edges[from].push_back(to);
+                ++graph.degrees[to];
+            }
+        }
+    }
+
+    /// Kahn's algorithm, ties are broken by the attach order
+    /// (or by the reverse attach order when unloading).
+    auto compare = [reverse](std::size_t lhs, std::size_t rhs)
+    {
+        return reverse ? lhs < rhs : lhs > rhs;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(compare)> ready(
+        compare);
+
+    auto degrees = graph.degrees;
+    for (std::size_t index = 0; index < graph.nodes.size(); ++index)
+    {
+        if (degrees[index] == 0)
+        {
+            ready.push(index);
+        }
+    }
+
+    while (!ready.empty())
+    {
+        const auto index = ready.top();
+        ready.pop();
+        graph.order.push_back(index);
+
+        for (auto next : graph.edges[index])
+        {
+            if (--degrees[next] == 0)
+            {
+                ready.push(next);
+            }
+        }
+    }
+
+    if (graph.order.size() != graph.nodes.size())
+    {
+        for (std::size_t index = 0; index < graph.nodes.size(); ++index)
+        {
+            if (degrees[index] != 0)
+            {
+                throw exception::dynamic_loader_error(
+                    "cyclic module dependency (path: {})",
+                    graph.nodes[index]->path());
+            }
+        }
+    }
+
+    return graph;
+}
+
+/**
+ * @brief Loads an attached module, or defers it if it is loaded on demand.
+ */
 void
-dynamic_loader::load_modules()
+load_module(dynamic_module &module)
 {
-    filter::iterate(
-        begin(),
-        end(),
-        [](auto &module)
+    if (module.on_demand())
+    {
+        module.defer();
+    }
+    else if (module.is_unloaded())
+    {
+        module.load();
+    }
+}
+
+/**
+ * @struct async_traversal
+ * @brief The state shared by the tasks of async_load_modules().
+ */
+struct async_traversal
+{
+    module_graph                          graph;    ///< The modules to load.
+    std::vector<std::atomic<std::size_t>> degrees;  ///< Dependencies left per module.
+    std::vector<std::promise<void>>       promises; ///< Completion per module.
+    std::vector<std::exception_ptr>       errors;   ///< Failures of dependencies.
+    std::mutex                            mutex;    ///< Guards the failures.
+};
+
+/**
+ * @brief Loads a module of an asynchronous traversal
+ *        and submits the dependents it unblocks.
+ */
+void
+load_async(const std::shared_ptr<async_traversal> &traversal,
+           executor                              &executor,
+           std::size_t                            index)
+{
+    std::exception_ptr error;
+    {
+        std::lock_guard lock(traversal->mutex);
+        error = traversal->errors[index];
+    }
+
+    if (!error)
+    {
+        try
+        {
+            load_module(*traversal->graph.nodes[index]);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+    }
+
+    if (error)
+    {
+        traversal->promises[index].set_exception(error);
+    }
+    else
+    {
+        traversal->promises[index].set_value();
+    }
+
+    for (auto next : traversal->graph.edges[index])
+    {
+        if (error)
         {
-            module->load();
-        },
-        [](const auto &module)
+            std::lock_guard lock(traversal->mutex);
+            if (!traversal->errors[next])
+            {
+                traversal->errors[next] = error;
+            }
+        }
+
+        if (traversal->degrees[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
         {
-            return module != nullptr && module->is_unloaded();
-        });
+            executor.submit(
+                [traversal, &executor, next]()
+                {
+                    load_async(traversal, executor, next);
+                });
+        }
+    }
 }
 
+} // namespace
+
 void
-dynamic_loader::unload_modules()
+dynamic_loader::traverse_modules(bool                                        reverse,
+                                 const std::function<void(dynamic_module &)> &action)
 {
-    filter::iterate(
-        rbegin(),
-        rend(),
-        [](auto &module)
+    const auto graph = make_module_graph(*this, reverse);
+
+    if (m_mode == LOAD_MODE_SEQUENTIAL)
+    {
+        for (auto index : graph.order)
+        {
+            action(*graph.nodes[index]);
+        }
+        return;
+    }
+
+    std::vector<std::atomic<std::size_t>> degrees(graph.nodes.size());
+    for (std::size_t index = 0; index < graph.nodes.size(); ++index)
+    {
+        degrees[index].store(graph.degrees[index], std::memory_order_relaxed);
+    }
+
+    std::atomic<bool>  failed(false);
+    std::exception_ptr error;
+    std::mutex         error_mutex;
+
+    thread_pool                      pool(m_workers);
+    std::function<void(std::size_t)> process = [&](std::size_t index)
+    {
+        if (failed.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        try
+        {
+            action(*graph.nodes[index]);
+        }
+        catch (...)
         {
-            module->unload();
-        },
-        [](const auto &module)
+            std::lock_guard lock(error_mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            failed.store(true, std::memory_order_release);
+            return;
+        }
+
+        for (auto next : graph.edges[index])
+        {
+            if (degrees[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                pool.submit(
+                    [&process, next]()
+                    {
+                        process(next);
+                    });
+            }
+        }
+    };
+
+    for (std::size_t index = 0; index < graph.nodes.size(); ++index)
+    {
+        if (graph.degrees[index] == 0)
+        {
+            pool.submit(
+                [&process, index]()
+                {
+                    process(index);
+                });
+        }
+    }
+
+    pool.wait();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void
+dynamic_loader::load_modules()
+{
+    trace::trace_scope scope("dynamic_loader::load_modules", path());
+    traverse_modules(false, load_module);
+}
+
+void
+dynamic_loader::unload_modules()
+{
+    trace::trace_scope scope("dynamic_loader::unload_modules", path());
+    traverse_modules(true,
+                     [](dynamic_module &module)
+                     {
+                         if (module.is_loaded() || module.is_pending())
+                         {
+                             module.unload();
+                         }
+                     });
+}
+
+std::unordered_map<const dynamic_module *, std::shared_future<void>>
+dynamic_loader::async_load_modules(executor &executor)
+{
+    auto traversal   = std::make_shared<async_traversal>();
+    traversal->graph = make_module_graph(*this, false);
+
+    const auto count = traversal->graph.nodes.size();
+
+    traversal->degrees  = std::vector<std::atomic<std::size_t>>(count);
+    traversal->promises = std::vector<std::promise<void>>(count);
+    traversal->errors.resize(count);
+
+    std::unordered_map<const dynamic_module *, std::shared_future<void>> futures;
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        traversal->degrees[index].store(traversal->graph.degrees[index],
+                                        std::memory_order_relaxed);
+        futures.emplace(traversal->graph.nodes[index],
+                        traversal->promises[index].get_future().share());
+    }
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        if (traversal->graph.degrees[index] == 0)
         {
-            return module != nullptr && module->is_loaded();
-        });
+            executor.submit(
+                [traversal, &executor, index]()
+                {
+                    load_async(traversal, executor, index);
+                });
+        }
+    }
+    return futures;
+}
+
+dynamic_module *
+dynamic_loader::find_module(std::string_view name) const
+{
+    return find_named(name);
 }
 
 void
-dynamic_loader::load()
+dynamic_loader::module_changed(dynamic_module &module) const
+{
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
+
+    const auto *info = module.known_info();
+    index_name(module,
+               info != nullptr ? std::optional<std::string_view>(info->name)
+                               : std::nullopt);
+}
+
+std::vector<fs::path_t>
+dynamic_loader::scan_modules(const fs::path_t &directory)
+{
+    std::vector<fs::path_t> candidates;
+
+    /// The directory entries cache the file type reported by the enumeration,
+    /// so filtering the candidates does not stat every file.
+    std::error_code error;
+    for (std::filesystem::recursive_directory_iterator
+             iterator(directory,
+                      std::filesystem::directory_options::skip_permission_denied,
+                      error),
+         end;
+         !error && iterator != end;
+         iterator.increment(error))
+    {
+        std::error_code type_error;
+        if (iterator->path().extension() == os::DYNAMIC_LIBRARY_EXTENSION &&
+            iterator->is_regular_file(type_error))
+        {
+            candidates.push_back(iterator->path());
+        }
+    }
+
+    if (error)
+    {
+        throw exception::dynamic_loader_error(
+            "failed to scan modules (path: {}, error: {})",
+            directory,
+            error.message());
+    }
+
+    std::vector<unsigned char> valid(candidates.size(), 0);
+    {
+        const auto  symbols  = dynamic_module::required_symbols();
+        const auto  verify   = preflight();
+        const auto *manifest = this->manifest();
+        thread_pool pool(m_workers);
+
+        for (std::size_t index = 0; index < candidates.size(); ++index)
+        {
+            pool.submit(
+                [&candidates, &valid, symbols, verify, manifest, index]()
+                {
+                    try
+                    {
+                        /// Most rejected candidates fail pre-flight validation,
+                        /// which reports them without throwing.
+                        if (fs::is_readable(candidates[index]) &&
+                            (!verify ||
+                             (manifest != nullptr &&
+                              manifest->find(candidates[index]) != nullptr) ||
+                             dl::try_preflight(candidates[index], symbols)))
+                        {
+                            valid[index] = 1;
+                        }
+                    }
+                    catch (const std::exception &)
+                    {
+                        /// The candidate is not a valid module.
+                    }
+                });
+        }
+        pool.wait();
+    }
+
+    std::size_t count = 0;
+    for (std::size_t index = 0; index < candidates.size(); ++index)
+    {
+        if (valid[index] != 0)
+        {
+            candidates[count++] = std::move(candidates[index]);
+        }
+    }
+    candidates.resize(count);
+
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+}
+
+dl::result<void>
+dynamic_loader::try_load()
 {
-    dynamic_module::load();
-    load_modules();
+    auto loaded = dynamic_module::try_load();
+    if (loaded)
+    {
+        try
+        {
+            load_modules();
+        }
+        catch (const std::exception &failure)
+        {
+            return dl::error(dl::errc::modules_failed, path(), failure.what());
+        }
+    }
+    return loaded;
 }
 
 void
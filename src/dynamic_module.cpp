@@ -1,42 +1,423 @@
+#include <algorithm>
+#include <mi/dynamic_loader.hpp>
 #include <mi/dynamic_module.hpp>
+#include <mi/module_note.hpp>
+#include <mi/trace_sink.hpp>
 
 using namespace mi;
 
+namespace
+{
+
+constexpr dl::symbol ON_MODULE_LOAD("on_module_load");     ///< Called after loading.
+constexpr dl::symbol ON_MODULE_UNLOAD("on_module_unload"); ///< Called before unloading.
+constexpr dl::symbol ON_MODULE_INFO("on_module_info");     ///< Describes the module.
+constexpr dl::symbol ON_MODULE_EXPORT_STATE("on_module_export_state"); ///< Hands off.
+constexpr dl::symbol ON_MODULE_IMPORT_STATE("on_module_import_state"); ///< Takes over.
+
+/**
+ * @brief The hooks checked by pre-flight validation.
+ */
+constexpr std::string_view REQUIRED_SYMBOLS[] = {
+    ON_MODULE_LOAD.name(),
+    ON_MODULE_UNLOAD.name(),
+    ON_MODULE_INFO.name(),
+};
+
+/**
+ * @brief Runs a member function on an executor.
+ *
+ * @return The future of the call, holding any exception it throws.
+ */
+template <typename ObjectType>
+std::future<void>
+submit_future(executor &executor, void (ObjectType::*function)(), ObjectType *object)
+{
+    /// Tasks have to be copyable, so the promise is shared with the task.
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future  = promise->get_future();
+    executor.submit(
+        [promise, function, object]()
+        {
+            try
+            {
+                (object->*function)();
+                promise->set_value();
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+        });
+    return future;
+}
+
+} // namespace
+
 void
 dynamic_module::load()
 {
-
     dynamic_library::load();
+}
+
+dl::result<void>
+dynamic_module::try_load()
+{
+    trace::trace_scope scope("dynamic_module::load", path());
+    for (auto *dependency : m_dependencies)
+    {
+        if (auto activated = dependency->try_activate(); !activated)
+        {
+            return activated;
+        }
+    }
+
+    if (auto loaded = dynamic_library::try_load(); !loaded)
+    {
+        return loaded;
+    }
+
+    /// Every load is accounted on its own, blocks leaked by a previous
+    /// load keep their account alive until they are freed. The account
+    /// is swapped only once the library opened, a failed or repeated
+    /// load leaves the account of the loaded version alone.
+    if (m_account != nullptr)
+    {
+        m_account->release();
+        m_account = nullptr;
+    }
+    if (memory_account::enabled())
+    {
+        m_account = memory_account::create();
+    }
+
+    exception::invoke_noexcept(&dynamic_module::snapshot, this);
+    if (m_manifest != nullptr && m_info != nullptr && image().empty())
+    {
+        exception::invoke_noexcept(&module_manifest::record, m_manifest, path(), *m_info);
+    }
+    notify_loader();
     exception::invoke_noexcept(
         [this]()
         {
-            this->call<void(dynamic_module &)>("on_module_load", *this);
+            trace::trace_scope scope(ON_MODULE_LOAD.name(), path());
+            call_hook<void(dynamic_module &)>(ON_MODULE_LOAD, *this);
         });
+    return {};
 }
 
 void
 dynamic_module::unload()
 {
-    exception::invoke_noexcept(
-        [this]()
-        {
-            this->call<void(dynamic_module &)>("on_module_unload", *this);
-        });
+    trace::trace_scope scope("dynamic_module::unload", path());
+    if (is_loaded())
+    {
+        exception::invoke_noexcept(
+            [this]()
+            {
+                trace::trace_scope scope(ON_MODULE_UNLOAD.name(), path());
+                call_hook<void(dynamic_module &)>(ON_MODULE_UNLOAD, *this);
+            });
+        exception::invoke_noexcept(&dynamic_module::release_memory, this);
+    }
+    m_info = nullptr;
     dynamic_library::unload();
+
+    if (m_manifest != nullptr && image().empty())
+    {
+        m_entry = m_manifest->find(path());
+    }
+
+    {
+        /// The file may be replaced before the module is loaded again.
+        std::lock_guard lock(m_note_mutex);
+        m_noted     = nullptr;
+        m_note_read = false;
+    }
+    notify_loader();
+}
+
+dynamic_module::~dynamic_module()
+{
+    if (m_account != nullptr)
+    {
+        m_account->release();
+    }
+}
+
+async_operation
+dynamic_module::async_load(executor &executor)
+{
+    return {executor,
+            [this]()
+            {
+                load();
+            }};
+}
+
+async_operation
+dynamic_module::async_unload(executor &executor)
+{
+    return {executor,
+            [this]()
+            {
+                unload();
+            }};
+}
+
+std::future<void>
+dynamic_module::load_future(executor &executor)
+{
+    return submit_future(executor, &dynamic_module::load, this);
+}
+
+std::future<void>
+dynamic_module::unload_future(executor &executor)
+{
+    return submit_future(executor, &dynamic_module::unload, this);
+}
+
+void
+dynamic_module::before_reload(os::dynamic_library_handle_t current,
+                              os::dynamic_library_handle_t next)
+{
+    auto *exporter = reinterpret_cast<void *(*)(dynamic_module &)>(
+        sym_unsafe(current, ON_MODULE_EXPORT_STATE.name()));
+
+    m_state.reset();
+    if (exporter != nullptr && sym_unsafe(next, ON_MODULE_IMPORT_STATE.name()) != nullptr)
+    {
+        m_state = exception::invoke_noexcept(
+            [this, exporter]()
+            {
+                memory_scope memory(m_account);
+                return exporter(*this);
+            });
+    }
+    else
+    {
+        exception::invoke_noexcept(
+            [this]()
+            {
+                call_hook<void(dynamic_module &)>(ON_MODULE_UNLOAD, *this);
+            });
+        /// No state refers to the arena, the new version starts with an empty one.
+        exception::invoke_noexcept(&dynamic_module::release_memory, this);
+    }
+    m_info = nullptr;
+}
+
+void
+dynamic_module::after_reload(os::dynamic_library_handle_t)
+{
+    exception::invoke_noexcept(&dynamic_module::snapshot, this);
+    notify_loader();
+    if (m_state.has_value())
+    {
+        exception::invoke_noexcept(
+            [this]()
+            {
+                call_hook<void(dynamic_module &, void *)>(ON_MODULE_IMPORT_STATE,
+                                                          *this,
+                                                          *m_state);
+            });
+        m_state.reset();
+    }
+    else
+    {
+        exception::invoke_noexcept(
+            [this]()
+            {
+                call_hook<void(dynamic_module &)>(ON_MODULE_LOAD, *this);
+            });
+    }
+}
+
+void
+dynamic_module::snapshot()
+{
+    m_info = &call<const module_info &()>(ON_MODULE_INFO);
+    publish_classname(m_info->name);
+}
+
+const std::string &
+dynamic_module::publish_classname(std::string_view name) const
+{
+    auto classname = format::interpolate_string(std::string_view("{}::{}"),
+                                                extension::classname(),
+                                                name);
+
+    std::lock_guard lock(m_classname_mutex);
+    auto found = std::find_if(m_classnames.begin(),
+                              m_classnames.end(),
+                              [&classname](const auto &published)
+                              {
+                                  return *published == classname;
+                              });
+    if (found == m_classnames.end())
+    {
+        m_classnames.push_back(std::make_unique<const std::string>(std::move(classname)));
+        found = std::prev(m_classnames.end());
+    }
+
+    m_classname.store(found->get(), std::memory_order_release);
+    return **found;
 }
 
 std::string
 dynamic_module::classname() const
 {
-    return format::interpolate_string(std::string_view("{}::{}"),
-                                      extension::classname(),
-                                      info().name);
+    if (const auto *published = m_classname.load(std::memory_order_acquire))
+    {
+        return *published;
+    }
+    else if (const auto *recorded = recorded_info())
+    {
+        return publish_classname(recorded->name);
+    }
+    return extension::classname();
 }
 
 const module_info &
 dynamic_module::info() const
 {
-    return call<const module_info &()>("on_module_info");
+    if (const auto *recorded = recorded_info())
+    {
+        return *recorded;
+    }
+
+    activate();
+    auto guard = pin();
+    if (m_info != nullptr)
+    {
+        return *m_info;
+    }
+    return call<const module_info &()>(ON_MODULE_INFO);
+}
+
+const module_info *
+dynamic_module::known_info() const noexcept
+{
+    if (m_info != nullptr)
+    {
+        return m_info;
+    }
+    return recorded_info();
+}
+
+const module_info *
+dynamic_module::noted_info() const noexcept
+{
+    std::lock_guard lock(m_note_mutex);
+    if (!m_note_read)
+    {
+        auto info = image().empty() ? dl::read_module_info(path())
+                                    : dl::read_module_info(image());
+        if (info.has_value())
+        {
+            m_noted = std::make_shared<const module_info>(std::move(*info));
+        }
+        m_note_read = true;
+    }
+    return m_noted.get();
+}
+
+const module_info *
+dynamic_module::recorded_info() const noexcept
+{
+    if (!is_unloaded())
+    {
+        return nullptr;
+    }
+    else if (m_entry != nullptr)
+    {
+        return &m_entry->info;
+    }
+    return noted_info();
+}
+
+void
+dynamic_module::manifest(module_manifest *manifest)
+{
+    m_manifest = manifest;
+    if (image().empty())
+    {
+        m_entry = manifest != nullptr ? manifest->find(path()) : nullptr;
+    }
+    notify_loader();
+}
+
+void
+dynamic_module::release_memory()
+{
+    const auto arena = m_arena.stats();
+    m_arena.release();
+    if (m_account != nullptr)
+    {
+        m_unfreed = m_account->stats();
+    }
+
+    if (logger().empty())
+    {
+        return;
+    }
+
+    if (arena.chunks != 0)
+    {
+        logger()->log(*this,
+                      LOGGER_DEBUG_LEVEL,
+                      format::interpolate_string(
+                          ustring_view(USTRING("arena released {} bytes in {} chunks "
+                                               "({} bytes in {} blocks used, path: {})")),
+                          arena.reserved_bytes,
+                          arena.chunks,
+                          arena.used_bytes,
+                          arena.allocations,
+                          path()));
+    }
+
+    if (const auto &stats = m_unfreed; stats.has_value() && stats->live_bytes != 0)
+    {
+        logger()->log(*this,
+                      LOGGER_WARNING_LEVEL,
+                      format::interpolate_string(
+                          ustring_view(USTRING("{} bytes in {} blocks not freed on unload "
+                                               "(peak: {} bytes, path: {})")),
+                          stats->live_bytes,
+                          stats->allocations - stats->deallocations,
+                          stats->peak_bytes,
+                          path()));
+    }
+}
+
+void
+dynamic_module::notify_loader() noexcept
+{
+    if (const auto *loader = dynamic_cast<const dynamic_loader *>(owner().ptr()))
+    {
+        exception::invoke_noexcept(&dynamic_loader::module_changed, loader, *this);
+    }
+}
+
+void
+dynamic_module::depends_on(dynamic_module &module)
+{
+    if (&module == this)
+    {
+        throw exception::dynamic_loader_error("module cannot depend on itself (path: {})",
+                                              path());
+    }
+    else if (std::find(m_dependencies.begin(), m_dependencies.end(), &module) ==
+             m_dependencies.end())
+    {
+        m_dependencies.push_back(&module);
+    }
+}
+
+std::span<const std::string_view>
+dynamic_module::required_symbols() const noexcept
+{
+    return REQUIRED_SYMBOLS;
 }
 
 fs::path_t
@@ -0,0 +1,348 @@
+#include <mi/elf_image.hpp>
+
+#ifdef MI_OS_LINUX
+#    include <cstring>
+#    include <dlfcn.h>
+#    include <link.h>
+#endif
+
+using namespace mi;
+using namespace mi::dl;
+
+#ifdef MI_OS_LINUX
+
+namespace
+{
+
+/**
+ * @brief Returns a bounds-checked pointer to an array of structures in the image.
+ *
+ * @param bytes The contents of the image.
+ * @param offset The offset of the first structure.
+ * @param count The number of structures.
+ * @return A pointer to the first structure.
+ *
+ * @throw dynamic_library_error If the range is outside the image or misaligned.
+ */
+template <typename Type>
+const Type *
+read(std::span<const std::byte> bytes, std::uint64_t offset, std::uint64_t count = 1)
+{
+    if (offset > bytes.size() || count > (bytes.size() - offset) / sizeof(Type) ||
+        offset % alignof(Type) != 0)
+    {
+        throw exception::dynamic_library_error(
+            "malformed ELF file, range out of bounds (offset: {}, size: {})",
+            offset,
+            count * sizeof(Type));
+    }
+    return reinterpret_cast<const Type *>(bytes.data() + offset);
+}
+
+/**
+ * @brief Returns the section header table of the image.
+ */
+std::span<const ElfW(Shdr)>
+sections(std::span<const std::byte> bytes)
+{
+    const auto *header = read<ElfW(Ehdr)>(bytes, 0);
+    if (header->e_shoff == 0 || header->e_shnum == 0)
+    {
+        return {};
+    }
+    else if (header->e_shentsize != sizeof(ElfW(Shdr)))
+    {
+        throw exception::dynamic_library_error(
+            "malformed ELF file, unexpected section header size (size: {})",
+            header->e_shentsize);
+    }
+    return {read<ElfW(Shdr)>(bytes, header->e_shoff, header->e_shnum),
+            header->e_shnum};
+}
+
+/**
+ * @brief Returns the section linked to another one, e.g. its string table.
+ */
+const ElfW(Shdr) &
+linked_section(std::span<const ElfW(Shdr)> sections, const ElfW(Shdr) &section)
+{
+    if (section.sh_link >= sections.size())
+    {
+        throw exception::dynamic_library_error(
+            "malformed ELF file, invalid section link (link: {})",
+            section.sh_link);
+    }
+    return sections[section.sh_link];
+}
+
+/**
+ * @brief Returns a NUL-terminated string stored in a string table section.
+ */
+std::string_view
+string_at(std::span<const std::byte> bytes, const ElfW(Shdr) &table, std::uint64_t offset)
+{
+    const auto *begin = read<char>(bytes, table.sh_offset, table.sh_size);
+    if (offset >= table.sh_size)
+    {
+        throw exception::dynamic_library_error(
+            "malformed ELF file, string out of bounds (offset: {})",
+            offset);
+    }
+
+    const auto *string = begin + offset;
+    const auto *end    = static_cast<const char *>(
+        std::memchr(string, '\0', table.sh_size - offset));
+    if (end == nullptr)
+    {
+        throw exception::dynamic_library_error(
+            "malformed ELF file, unterminated string (offset: {})",
+            offset);
+    }
+    return {string, static_cast<std::size_t>(end - string)};
+}
+
+/**
+ * @brief Returns the ELF header of the running process image.
+ */
+const ElfW(Ehdr) &
+native_header()
+{
+    Dl_info info{};
+    dladdr(reinterpret_cast<const void *>(&native_header), &info);
+    return *static_cast<const ElfW(Ehdr) *>(info.dli_fbase);
+}
+
+} // namespace
+
+elf_image::elf_image(std::span<const std::byte> bytes)
+    : m_bytes(bytes),
+      m_machine(EM_NONE),
+      m_type(ET_NONE)
+{
+    if (bytes.size() < sizeof(ElfW(Ehdr)) ||
+        std::memcmp(bytes.data(), ELFMAG, SELFMAG) != 0)
+    {
+        throw exception::dynamic_library_error("not an ELF file");
+    }
+
+    const auto &native = native_header();
+    const auto *header = read<ElfW(Ehdr)>(bytes, 0);
+    if (header->e_ident[EI_CLASS] != native.e_ident[EI_CLASS])
+    {
+        throw exception::dynamic_library_error("unsupported ELF class (class: {})",
+                                               int(header->e_ident[EI_CLASS]));
+    }
+    else if (header->e_ident[EI_DATA] != native.e_ident[EI_DATA])
+    {
+        throw exception::dynamic_library_error("unsupported ELF byte order (data: {})",
+                                               int(header->e_ident[EI_DATA]));
+    }
+
+    m_machine = header->e_machine;
+    m_type    = header->e_type;
+}
+
+bool
+elf_image::is_loadable() const noexcept
+{
+    return m_type == ET_DYN && m_machine == native_header().e_machine;
+}
+
+std::vector<std::string_view>
+elf_image::exported_symbols() const
+{
+    std::vector<std::string_view> names;
+
+    const auto all = sections(m_bytes);
+    for (const auto &section : all)
+    {
+        if (section.sh_type != SHT_DYNSYM)
+        {
+            continue;
+        }
+
+        const auto &strings = linked_section(all, section);
+        const auto  count   = section.sh_size / sizeof(ElfW(Sym));
+        const auto *symbols = read<ElfW(Sym)>(m_bytes, section.sh_offset, count);
+
+        for (std::uint64_t index = 0; index < count; ++index)
+        {
+            const auto &symbol     = symbols[index];
+            const auto  binding    = ELF64_ST_BIND(symbol.st_info);
+            const auto  visibility = ELF64_ST_VISIBILITY(symbol.st_other);
+
+            if (symbol.st_shndx != SHN_UNDEF && symbol.st_name != 0 &&
+                (binding == STB_GLOBAL || binding == STB_WEAK ||
+                 binding == STB_GNU_UNIQUE) &&
+                (visibility == STV_DEFAULT || visibility == STV_PROTECTED))
+            {
+                names.push_back(string_at(m_bytes, strings, symbol.st_name));
+            }
+        }
+    }
+    return names;
+}
+
+std::span<const std::byte>
+elf_image::note(std::string_view owner, std::uint32_t type) const
+{
+    for (const auto &section : sections(m_bytes))
+    {
+        if (section.sh_type != SHT_NOTE)
+        {
+            continue;
+        }
+
+        /// Names and descriptors are padded to the alignment of the section,
+        /// which is 4 for most notes and 8 for a few 64-bit ones.
+        const std::uint64_t align  = section.sh_addralign == 8 ? 8 : 4;
+        auto                padded = [align](std::uint64_t size)
+        {
+            return (size + align - 1) & ~(align - 1);
+        };
+
+        const std::span notes(read<std::byte>(m_bytes, section.sh_offset, section.sh_size),
+                              section.sh_size);
+
+        for (std::uint64_t offset = 0; offset + sizeof(ElfW(Nhdr)) <= notes.size();)
+        {
+            const auto *header = read<ElfW(Nhdr)>(notes, offset);
+            const auto  name   = offset + sizeof(ElfW(Nhdr));
+            const auto  desc   = name + padded(header->n_namesz);
+            const auto  next   = desc + padded(header->n_descsz);
+            if (next > notes.size())
+            {
+                throw exception::dynamic_library_error(
+                    "malformed ELF file, note out of bounds (offset: {})",
+                    section.sh_offset + offset);
+            }
+
+            /// The stored name includes its terminating NUL.
+            const std::string_view stored(read<char>(notes, name, header->n_namesz),
+                                          header->n_namesz);
+            if (header->n_type == type && stored.size() == owner.size() + 1 &&
+                stored.substr(0, owner.size()) == owner)
+            {
+                return notes.subspan(desc, header->n_descsz);
+            }
+            offset = next;
+        }
+    }
+    return {};
+}
+
+std::span<const std::byte>
+elf_image::build_id() const
+{
+    return note("GNU", NT_GNU_BUILD_ID);
+}
+
+std::vector<std::string_view>
+elf_image::dynamic_strings(std::int64_t tag) const
+{
+    std::vector<std::string_view> values;
+
+    const auto all = sections(m_bytes);
+    for (const auto &section : all)
+    {
+        if (section.sh_type != SHT_DYNAMIC)
+        {
+            continue;
+        }
+
+        const auto &strings = linked_section(all, section);
+        const auto  count   = section.sh_size / sizeof(ElfW(Dyn));
+        const auto *entries = read<ElfW(Dyn)>(m_bytes, section.sh_offset, count);
+
+        for (std::uint64_t index = 0; index < count && entries[index].d_tag != DT_NULL;
+             ++index)
+        {
+            if (entries[index].d_tag == tag)
+            {
+                values.push_back(string_at(m_bytes, strings, entries[index].d_un.d_val));
+            }
+        }
+    }
+    return values;
+}
+
+std::vector<std::string_view>
+elf_image::needed() const
+{
+    return dynamic_strings(DT_NEEDED);
+}
+
+std::string_view
+elf_image::runpath() const
+{
+    const auto values = dynamic_strings(DT_RUNPATH);
+    return values.empty() ? std::string_view() : values.front();
+}
+
+std::string_view
+elf_image::rpath() const
+{
+    const auto values = dynamic_strings(DT_RPATH);
+    return values.empty() ? std::string_view() : values.front();
+}
+
+#else
+
+elf_image::elf_image(std::span<const std::byte> bytes)
+    : m_bytes(bytes),
+      m_machine(0),
+      m_type(0)
+{
+    throw exception::dynamic_library_error(
+        "ELF images are not supported on this platform");
+}
+
+bool
+elf_image::is_loadable() const noexcept
+{
+    return false;
+}
+
+std::vector<std::string_view>
+elf_image::exported_symbols() const
+{
+    return {};
+}
+
+std::span<const std::byte>
+elf_image::note(std::string_view, std::uint32_t) const
+{
+    return {};
+}
+
+std::span<const std::byte>
+elf_image::build_id() const
+{
+    return {};
+}
+
+std::vector<std::string_view>
+elf_image::dynamic_strings(std::int64_t) const
+{
+    return {};
+}
+
+std::vector<std::string_view>
+elf_image::needed() const
+{
+    return {};
+}
+
+std::string_view
+elf_image::runpath() const
+{
+    return {};
+}
+
+std::string_view
+elf_image::rpath() const
+{
+    return {};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <limits>
+#include <mi/epoch.hpp>
+
+using namespace mi;
+
+namespace
+{
+
+/**
+ * @brief The epoch announced by threads outside of read-side sections.
+ */
+constexpr std::uint64_t IDLE_EPOCH = std::numeric_limits<std::uint64_t>::max();
+
+} // namespace
+
+struct epoch_domain::reader
+{
+    std::atomic<std::uint64_t> epoch{IDLE_EPOCH}; ///< The announced epoch.
+    std::atomic<bool>          taken{false};      ///< Owned by a thread.
+    reader                    *next  = nullptr;   ///< The next record.
+    unsigned                   depth = 0;         ///< Nested sections of the owner.
+};
+
+epoch_domain &
+epoch_domain::instance() noexcept
+{
+    static epoch_domain domain;
+    return domain;
+}
+
+epoch_domain::reader &
+epoch_domain::local_reader() noexcept
+{
+    /**
+     * @brief Hands the record of an exiting thread back to the domain.
+     */
+    struct holder
+    {
+        reader *record = nullptr;
+
+        ~holder()
+        {
+            if (record != nullptr)
+            {
+                record->epoch.store(IDLE_EPOCH, std::memory_order_release);
+                record->taken.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local holder local;
+    if (local.record != nullptr)
+    {
+        return *local.record;
+    }
+
+    /// Records of exited threads are reused, new ones are never freed,
+    /// so writers can walk the list without synchronizing with readers.
+    for (auto *record = m_readers.load(std::memory_order_acquire); record != nullptr;
+         record       = record->next)
+    {
+        bool expected = false;
+        if (!record->taken.load(std::memory_order_relaxed) &&
+            record->taken.compare_exchange_strong(expected,
+                                                  true,
+                                                  std::memory_order_acquire))
+        {
+            local.record = record;
+            return *record;
+        }
+    }
+
+    auto *record = new reader;
+    record->taken.store(true, std::memory_order_relaxed);
+    record->next = m_readers.load(std::memory_order_relaxed);
+    while (!m_readers.compare_exchange_weak(record->next,
+                                            record,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed))
+    {
+    }
+    local.record = record;
+    return *record;
+}
+
+void
+epoch_domain::enter() noexcept
+{
+    auto &record = local_reader();
+    if (record.depth++ == 0)
+    {
+        /// The announcement has to be visible to writers
+        /// before the reader loads any published pointer.
+        record.epoch.store(m_epoch.load(std::memory_order_acquire),
+                           std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void
+epoch_domain::leave() noexcept
+{
+    auto &record = local_reader();
+    if (--record.depth == 0)
+    {
+        record.epoch.store(IDLE_EPOCH, std::memory_order_release);
+    }
+}
+
+void
+epoch_domain::retire(void *object, deleter_t deleter)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_retired.push_back(
+            {m_epoch.fetch_add(1, std::memory_order_seq_cst), object, deleter});
+    }
+    reclaim();
+}
+
+std::size_t
+epoch_domain::reclaim()
+{
+    std::vector<retired> expired;
+    std::size_t          remaining = 0;
+    {
+        std::lock_guard lock(m_mutex);
+        const auto      oldest = oldest_epoch();
+
+        /// Readers that announced the epoch of an object, or an older one,
+        /// may have loaded it before it was unpublished.
+        const auto first = std::partition(m_retired.begin(),
+                                          m_retired.end(),
+                                          [oldest](const retired &object)
+                                          {
+                                              return object.epoch >= oldest;
+                                          });
+        expired.assign(first, m_retired.end());
+        m_retired.erase(first, m_retired.end());
+        remaining = m_retired.size();
+    }
+
+    for (const auto &object : expired)
+    {
+        object.deleter(object.object);
+    }
+    return remaining;
+}
+
+std::uint64_t
+epoch_domain::oldest_epoch() const noexcept
+{
+    auto oldest = IDLE_EPOCH;
+    for (auto *record = m_readers.load(std::memory_order_acquire); record != nullptr;
+         record       = record->next)
+    {
+        oldest = std::min(oldest, record->epoch.load(std::memory_order_seq_cst));
+    }
+    return oldest;
+}
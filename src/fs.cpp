@@ -1,5 +1,7 @@
 #include <mi/bitflag.hpp>
+#include <fstream>
 #include <mi/fs.hpp>
+#include <mi/fs_error.hpp>
 
 using namespace mi;
 using namespace mi::fs;
@@ -29,4 +31,33 @@ fs::is_executable(const fs::path_t &path)
     return BITFLAG_CHECK(perms, perms_t::owner_exec) != perms_t::none ||
            BITFLAG_CHECK(perms, perms_t::group_exec) != perms_t::none ||
            BITFLAG_CHECK(perms, perms_t::others_exec) != perms_t::none;
-}
\ No newline at end of file
+}
+
+void
+fs::replace_file(const path_t &path, std::string_view contents)
+{
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        stream.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        stream.close();
+        if (!stream)
+        {
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            throw exception::fs_error("failed to write file (path: {})", temporary);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::error_code ignored;
+        std::filesystem::remove(temporary, ignored);
+        throw exception::fs_error("failed to replace file (path: {}, error: {})",
+                                  path,
+                                  error.message());
+    }
+}
@@ -0,0 +1,232 @@
+#include <mi/gnu_hash_resolver.hpp>
+
+#ifdef MI_OS_LINUX
+#    include <cstring>
+#    include <dlfcn.h>
+#    include <link.h>
+#endif
+
+using namespace mi;
+using namespace mi::dl;
+
+#ifdef MI_OS_LINUX
+
+namespace
+{
+
+/**
+ * @struct phdr_query
+ * @brief Parameters and result of the program header search.
+ */
+struct phdr_query
+{
+    ElfW(Addr)       base;    ///< The load bias of the wanted object.
+    const ElfW(Dyn) *dynamic; ///< The dynamic section of the object, if found.
+};
+
+int
+find_dynamic_section(struct dl_phdr_info *info, size_t, void *data)
+{
+    auto *query = static_cast<phdr_query *>(data);
+    if (info->dlpi_addr != query->base)
+    {
+        return 0;
+    }
+
+    for (ElfW(Half) index = 0; index < info->dlpi_phnum; ++index)
+    {
+        if (info->dlpi_phdr[index].p_type == PT_DYNAMIC)
+        {
+            query->dynamic = reinterpret_cast<const ElfW(Dyn) *>(
+                info->dlpi_addr + info->dlpi_phdr[index].p_vaddr);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Computes the GNU hash of a symbol name.
+ */
+std::uint32_t
+gnu_hash(std::string_view name) noexcept
+{
+    std::uint32_t hash = 5381;
+    for (const auto character : name)
+    {
+        hash = hash * 33 + static_cast<unsigned char>(character);
+    }
+    return hash;
+}
+
+} // namespace
+
+gnu_hash_resolver::gnu_hash_resolver(const dynamic_library &library)
+    : m_library(library)
+{
+    if (library.is_unloaded())
+    {
+        throw exception::dynamic_library_error(
+            "failed to index symbols, dynamic library is not loaded (path: {})",
+            library.path());
+    }
+
+    struct link_map *map = nullptr;
+    if (dlinfo(library.native_handle(), RTLD_DI_LINKMAP, &map) != 0 || map == nullptr)
+    {
+        return;
+    }
+
+    phdr_query query{map->l_addr, nullptr};
+    dl_iterate_phdr(&find_dynamic_section, &query);
+    if (query.dynamic == nullptr)
+    {
+        return;
+    }
+
+    m_base = map->l_addr;
+
+    /// Depending on the architecture the dynamic linker may or may not
+    /// have relocated the pointers stored in the dynamic section.
+    auto address = [this](ElfW(Addr) pointer)
+    {
+        return pointer < m_base ? m_base + pointer : pointer;
+    };
+
+    const std::uint32_t *hash_table = nullptr;
+    for (const auto *entry = query.dynamic; entry->d_tag != DT_NULL; ++entry)
+    {
+        switch (entry->d_tag)
+        {
+        case DT_GNU_HASH:
+            hash_table = reinterpret_cast<const std::uint32_t *>(
+                address(entry->d_un.d_ptr));
+            break;
+        case DT_SYMTAB:
+            m_symtab = reinterpret_cast<const void *>(address(entry->d_un.d_ptr));
+            break;
+        case DT_STRTAB:
+            m_strtab = reinterpret_cast<const char *>(address(entry->d_un.d_ptr));
+            break;
+        case DT_VERSYM:
+            m_versym = reinterpret_cast<const std::uint16_t *>(
+                address(entry->d_un.d_ptr));
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (hash_table == nullptr || m_symtab == nullptr || m_strtab == nullptr)
+    {
+        return;
+    }
+
+    /// An empty or malformed table would be divided by zero,
+    /// such libraries are left to the platform loader.
+    if (hash_table[0] == 0 || hash_table[2] == 0)
+    {
+        return;
+    }
+
+    m_bucket_count  = hash_table[0];
+    m_symbol_offset = hash_table[1];
+    m_bloom_size    = hash_table[2];
+    m_bloom_shift   = hash_table[3];
+    m_bloom         = reinterpret_cast<const std::uintptr_t *>(hash_table + 4);
+    m_buckets       = reinterpret_cast<const std::uint32_t *>(m_bloom + m_bloom_size);
+    m_chain         = m_buckets + m_bucket_count;
+}
+
+os::dynamic_library_func_t
+gnu_hash_resolver::lookup(std::string_view name) const noexcept
+{
+    constexpr std::uint32_t word_bits = sizeof(std::uintptr_t) * 8;
+
+    const auto hash = gnu_hash(name);
+    const auto word = m_bloom[(hash / word_bits) % m_bloom_size];
+    const auto mask = (std::uintptr_t(1) << (hash % word_bits)) |
+                      (std::uintptr_t(1) << ((hash >> m_bloom_shift) % word_bits));
+
+    if ((word & mask) != mask)
+    {
+        return nullptr;
+    }
+
+    auto index = m_buckets[hash % m_bucket_count];
+    if (index < m_symbol_offset)
+    {
+        return nullptr;
+    }
+
+    const auto *symbols = static_cast<const ElfW(Sym) *>(m_symtab);
+    for (;; ++index)
+    {
+        const auto chain_hash = m_chain[index - m_symbol_offset];
+        if ((chain_hash | 1) == (hash | 1))
+        {
+            const auto &symbol = symbols[index];
+            const auto *string = m_strtab + symbol.st_name;
+            if (std::strncmp(string, name.data(), name.size()) == 0 &&
+                string[name.size()] == '\0' && symbol.st_shndx != SHN_UNDEF)
+            {
+                const auto type = ELF64_ST_TYPE(symbol.st_info);
+                if (type == STT_GNU_IFUNC || type == STT_TLS ||
+                    (m_versym != nullptr && (m_versym[index] & 0x7fff) > 1))
+                {
+                    return nullptr;
+                }
+                return reinterpret_cast<os::dynamic_library_func_t>(m_base +
+                                                                     symbol.st_value);
+            }
+        }
+
+        if (chain_hash & 1)
+        {
+            return nullptr;
+        }
+    }
+}
+
+os::dynamic_library_func_t
+gnu_hash_resolver::resolve(std::string_view name) const
+{
+    if (is_indexed())
+    {
+        if (auto address = lookup(name))
+        {
+            return address;
+        }
+    }
+
+    /// Symbols the table cannot answer, including those defined
+    /// in dependencies of the library, go through the platform loader.
+    return m_library.sym_unsafe(name);
+}
+
+#else
+
+gnu_hash_resolver::gnu_hash_resolver(const dynamic_library &library)
+    : m_library(library)
+{
+    if (library.is_unloaded())
+    {
+        throw exception::dynamic_library_error(
+            "failed to index symbols, dynamic library is not loaded (path: {})",
+            library.path());
+    }
+}
+
+os::dynamic_library_func_t
+gnu_hash_resolver::lookup(std::string_view) const noexcept
+{
+    return nullptr;
+}
+
+os::dynamic_library_func_t
+gnu_hash_resolver::resolve(std::string_view name) const
+{
+    return m_library.sym_unsafe(name);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <mi/fs_error.hpp>
+#include <mi/mapped_file.hpp>
+#include <mi/os.hpp>
+
+#ifdef MI_OS_UNIX_LIKE
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#endif
+
+using namespace mi;
+using namespace mi::fs;
+
+mapped_file::mapped_file(const path_t &path)
+    : m_data(nullptr),
+      m_size(0)
+{
+#ifdef MI_OS_UNIX_LIKE
+    const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+    {
+        throw exception::fs_error("failed to open file (path: {}, error: {})",
+                                  path,
+                                  os::last_error_message());
+    }
+
+    struct stat status{};
+    if (::fstat(descriptor, &status) != 0)
+    {
+        const auto message = os::last_error_message();
+        ::close(descriptor);
+        throw exception::fs_error("failed to stat file (path: {}, error: {})",
+                                  path,
+                                  message);
+    }
+
+    if (status.st_size > 0)
+    {
+        auto *data = ::mmap(nullptr,
+                            static_cast<std::size_t>(status.st_size),
+                            PROT_READ,
+                            MAP_PRIVATE,
+                            descriptor,
+                            0);
+        if (data == MAP_FAILED)
+        {
+            const auto message = os::last_error_message();
+            ::close(descriptor);
+            throw exception::fs_error("failed to map file (path: {}, error: {})",
+                                      path,
+                                      message);
+        }
+        m_data = data;
+        m_size = static_cast<std::size_t>(status.st_size);
+    }
+    ::close(descriptor);
+#else
+    auto file = CreateFileW(path.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw exception::fs_error("failed to open file (path: {}, error: {})",
+                                  path,
+                                  os::last_error_message());
+    }
+
+    LARGE_INTEGER size{};
+    GetFileSizeEx(file, &size);
+    if (size.QuadPart > 0)
+    {
+        auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+
+        if (m_data == nullptr)
+        {
+            const auto message = os::last_error_message();
+            CloseHandle(file);
+            throw exception::fs_error("failed to map file (path: {}, error: {})",
+                                      path,
+                                      message);
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+    }
+    CloseHandle(file);
+#endif
+}
+
+mapped_file::mapped_file(mapped_file &&other) noexcept
+    : m_data(other.m_data),
+      m_size(other.m_size)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+mapped_file::~mapped_file()
+{
+    if (m_data != nullptr)
+    {
+#ifdef MI_OS_UNIX_LIKE
+        ::munmap(const_cast<void *>(m_data), m_size);
+#else
+        UnmapViewOfFile(m_data);
+#endif
+    }
+}
@@ -0,0 +1,225 @@
+#include <cstddef>
+#include <cstdlib>
+#include <mi/memory_account.hpp>
+#include <new>
+
+using namespace mi;
+
+bool
+memory_account::supported() noexcept
+{
+#ifdef MI_MEMORY_ACCOUNTING
+    return true;
+#else
+    return false;
+#endif
+}
+
+memory_account *
+memory_account::create()
+{
+    /// The account is allocated on behalf of no module.
+    memory_scope scope(nullptr);
+    return new memory_account();
+}
+
+void
+memory_account::release() noexcept
+{
+    if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete this;
+    }
+}
+
+void
+memory_account::allocated(std::size_t size) noexcept
+{
+    retain();
+    m_allocations.fetch_add(1, std::memory_order_relaxed);
+    m_allocated.fetch_add(size, std::memory_order_relaxed);
+
+    const auto live = m_live.fetch_add(size, std::memory_order_relaxed) + size;
+    auto       peak = m_peak.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !m_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+memory_account::freed(std::size_t size) noexcept
+{
+    m_deallocations.fetch_add(1, std::memory_order_relaxed);
+    m_live.fetch_sub(size, std::memory_order_relaxed);
+    release();
+}
+
+memory_stats
+memory_account::stats() const noexcept
+{
+    return {m_live.load(std::memory_order_relaxed),
+            m_peak.load(std::memory_order_relaxed),
+            m_allocated.load(std::memory_order_relaxed),
+            m_allocations.load(std::memory_order_relaxed),
+            m_deallocations.load(std::memory_order_relaxed),
+            std::chrono::steady_clock::now()};
+}
+
+#ifdef MI_MEMORY_ACCOUNTING
+
+namespace
+{
+
+/**
+ * @struct block_header
+ * @brief Precedes every block, so that it is freed from the right account.
+ */
+struct block_header
+{
+    memory_account *account; ///< The account, nullptr if not attributed.
+    std::size_t     size;    ///< The size requested by the caller.
+};
+
+/**
+ * @brief The size of the header, keeps the blocks fundamentally aligned.
+ */
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+static_assert(sizeof(block_header) <= HEADER_SIZE);
+
+/**
+ * @brief Allocates a block and attributes it to the selected account.
+ * @return The block, or nullptr if the heap is exhausted.
+ */
+void *
+allocate(std::size_t size) noexcept
+{
+    auto *block = static_cast<unsigned char *>(std::malloc(HEADER_SIZE + size));
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto *account = memory_account::enabled() ? memory_account::current() : nullptr;
+    if (account != nullptr)
+    {
+        account->allocated(size);
+    }
+    ::new (block) block_header{account, size};
+    return block + HEADER_SIZE;
+}
+
+/**
+ * @brief Allocates a block, calling the new handler until it succeeds.
+ * @throw std::bad_alloc If the heap is exhausted and no new handler is set.
+ */
+void *
+allocate_or_throw(std::size_t size)
+{
+    for (;;)
+    {
+        if (auto *block = allocate(size))
+        {
+            return block;
+        }
+        else if (auto handler = std::get_new_handler())
+        {
+            handler();
+        }
+        else
+        {
+            throw std::bad_alloc();
+        }
+    }
+}
+
+/**
+ * @brief Takes a block off its account and frees it.
+ */
+void
+deallocate(void *pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+
+    auto *block  = static_cast<unsigned char *>(pointer) - HEADER_SIZE;
+    auto *header = reinterpret_cast<block_header *>(block);
+    if (header->account != nullptr)
+    {
+        header->account->freed(header->size);
+    }
+    std::free(block);
+}
+
+} // namespace
+
+void *
+operator new(std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void *
+operator new[](std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void *
+operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate_or_throw(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *
+operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void
+operator delete(void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void
+operator delete[](void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void
+operator delete(void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void
+operator delete[](void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void
+operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+void
+operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include <mi/module_arena.hpp>
+#include <new>
+
+using namespace mi;
+
+namespace
+{
+
+/**
+ * @brief The space taken by the header of a chunk, keeps the blocks aligned.
+ */
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+/**
+ * @brief Rounds a pointer up to an alignment.
+ */
+std::byte *
+align_up(std::byte *pointer, std::size_t alignment) noexcept
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+    return pointer + ((alignment - address % alignment) % alignment);
+}
+
+} // namespace
+
+void *
+module_arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::lock_guard lock(m_mutex);
+    auto           *block = align_up(m_cursor, alignment);
+    if (m_cursor == nullptr || block + bytes > m_end)
+    {
+        /// Over-aligned blocks may need up to alignment - 1 bytes of padding.
+        const auto padding  = alignment > HEADER_SIZE ? alignment - 1 : 0;
+        const auto required = HEADER_SIZE + padding + bytes;
+        const auto size     = required > m_chunk_size ? required : m_chunk_size;
+
+        auto *header = ::new (::operator new(size)) chunk{nullptr, size};
+        auto *start  = reinterpret_cast<std::byte *>(header) + HEADER_SIZE;
+        block        = align_up(start, alignment);
+        ++m_stats.chunks;
+        m_stats.reserved_bytes += size;
+
+        if (size != m_chunk_size && m_chunks != nullptr)
+        {
+            /// An oversized block gets a chunk of its own,
+            /// the free space of the current chunk is kept.
+            header->next   = m_chunks->next;
+            m_chunks->next = header;
+            ++m_stats.allocations;
+            m_stats.used_bytes += bytes;
+            return block;
+        }
+
+        header->next = m_chunks;
+        m_chunks     = header;
+        m_end        = reinterpret_cast<std::byte *>(header) + size;
+    }
+
+    m_cursor = block + bytes;
+    ++m_stats.allocations;
+    m_stats.used_bytes += bytes;
+    return block;
+}
+
+void
+module_arena::do_deallocate(void *, std::size_t, std::size_t)
+{
+}
+
+bool
+module_arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+void
+module_arena::release() noexcept
+{
+    std::lock_guard lock(m_mutex);
+    while (m_chunks != nullptr)
+    {
+        auto *next = m_chunks->next;
+        ::operator delete(m_chunks);
+        m_chunks = next;
+    }
+
+    m_cursor = nullptr;
+    m_end    = nullptr;
+    m_stats  = {0, 0, 0, 0, m_stats.releases + 1};
+}
+
+arena_stats
+module_arena::stats() const noexcept
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+module_arena::~module_arena()
+{
+    release();
+}
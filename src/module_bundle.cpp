@@ -0,0 +1,205 @@
+#include <mi/binary_stream.hpp>
+#include <mi/dynamic_loader_error.hpp>
+#include <mi/elf_image.hpp>
+#include <mi/module_bundle.hpp>
+#include <unordered_set>
+
+using namespace mi;
+
+namespace
+{
+
+constexpr char          BUNDLE_MAGIC[4] = {'M', 'I', 'B', 'N'}; ///< File signature.
+constexpr std::uint32_t BUNDLE_VERSION  = 1;          ///< Layout of the file.
+constexpr std::uint32_t BUNDLE_ORDER    = 0x01020304; ///< Detects the byte order.
+
+/**
+ * @brief Rounds an offset up to a multiple of a power of two.
+ */
+std::uint64_t
+align_up(std::uint64_t offset, std::uint64_t alignment) noexcept
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Returns the build identifier of a module image, empty if it has none.
+ */
+std::string
+read_build_id(std::span<const std::byte> image)
+{
+    try
+    {
+        const auto id = dl::elf_image(image).build_id();
+        return {reinterpret_cast<const char *>(id.data()), id.size()};
+    }
+    catch (const std::exception &)
+    {
+        return {};
+    }
+}
+
+/**
+ * @brief Serializes the header and the index of a bundle.
+ *
+ * @param sources The members of the bundle.
+ * @param images The member images, in the order of the sources.
+ * @param offsets The offsets of the images in the bundle.
+ * @param build_ids The build identifiers of the images.
+ * @param alignment The alignment of the images.
+ */
+std::string
+write_index(std::span<const module_bundle_source> sources,
+            std::span<const fs::mapped_file>      images,
+            std::span<const std::uint64_t>        offsets,
+            std::span<const std::string>          build_ids,
+            std::uint32_t                         alignment)
+{
+    binary_writer writer;
+    writer.bytes(std::string_view(BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)));
+    writer.u32(BUNDLE_VERSION);
+    writer.u32(BUNDLE_ORDER);
+    writer.u32(alignment);
+    writer.u32(static_cast<std::uint32_t>(sources.size()));
+
+    for (std::size_t index = 0; index < sources.size(); ++index)
+    {
+        writer.string(sources[index].name);
+        writer.u64(offsets[index]);
+        writer.u64(images[index].size());
+        writer.string(build_ids[index]);
+        writer.string(sources[index].info.author);
+        writer.string(sources[index].info.name);
+        writer.string(sources[index].info.version);
+        writer.string(sources[index].info.description);
+    }
+    return writer.buffer();
+}
+
+} // namespace
+
+const module_bundle_member *
+module_bundle::find(std::string_view name) const noexcept
+{
+    for (const auto &member : m_members)
+    {
+        if (member.name == name)
+        {
+            return &member;
+        }
+    }
+    return nullptr;
+}
+
+void
+module_bundle::write(const fs::path_t                     &path,
+                     std::span<const module_bundle_source> sources,
+                     std::uint32_t                         alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        throw exception::dynamic_loader_error(
+            "bundle alignment is not a power of two (alignment: {}, path: {})",
+            alignment,
+            path);
+    }
+
+    std::unordered_set<std::string_view> names;
+    std::vector<fs::mapped_file>         images;
+    std::vector<std::string>             build_ids;
+    images.reserve(sources.size());
+
+    for (const auto &source : sources)
+    {
+        if (!names.insert(source.name).second)
+        {
+            throw exception::dynamic_loader_error(
+                "duplicate bundle member (name: {}, path: {})",
+                source.name,
+                path);
+        }
+        images.emplace_back(source.path);
+        build_ids.push_back(read_build_id(images.back().bytes()));
+    }
+
+    /// The index has a fixed size for given names and descriptions,
+    /// so it is measured first with placeholder offsets.
+    std::vector<std::uint64_t> offsets(sources.size());
+    auto offset = align_up(write_index(sources, images, offsets, build_ids, alignment).size(),
+                           alignment);
+    for (std::size_t index = 0; index < sources.size(); ++index)
+    {
+        offsets[index] = offset;
+        offset         = align_up(offset + images[index].size(), alignment);
+    }
+
+    auto contents = write_index(sources, images, offsets, build_ids, alignment);
+    for (std::size_t index = 0; index < sources.size(); ++index)
+    {
+        const auto bytes = images[index].bytes();
+        contents.resize(offsets[index], '\0');
+        contents.append(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    }
+
+    fs::replace_file(path, contents);
+}
+
+module_bundle::module_bundle(fs::path_t path)
+    : m_path(std::move(path)),
+      m_file(m_path)
+{
+    const auto bytes = m_file.bytes();
+    if (bytes.size() < sizeof(BUNDLE_MAGIC) ||
+        std::memcmp(bytes.data(), BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0)
+    {
+        throw exception::dynamic_loader_error("not a module bundle (path: {})", m_path);
+    }
+
+    binary_reader reader(bytes.subspan(sizeof(BUNDLE_MAGIC)));
+    if (reader.u32() != BUNDLE_VERSION || reader.u32() != BUNDLE_ORDER)
+    {
+        throw exception::dynamic_loader_error("unsupported module bundle (path: {})",
+                                              m_path);
+    }
+
+    const auto alignment = reader.u32();
+    const auto count     = reader.u32();
+    for (std::uint32_t index = 0; index < count && !reader.failed(); ++index)
+    {
+        auto       name        = reader.string();
+        const auto offset      = reader.u64();
+        const auto size        = reader.u64();
+        auto       build_id    = reader.string();
+        auto       author      = reader.string();
+        auto       module_name = reader.string();
+        auto       version     = reader.string();
+        auto       description = reader.string();
+
+        if (reader.failed() || offset > bytes.size() || size > bytes.size() - offset ||
+            (alignment != 0 && offset % alignment != 0))
+        {
+            throw exception::dynamic_loader_error(
+                "malformed module bundle, member out of bounds (member: {}, path: {})",
+                name,
+                m_path);
+        }
+
+        m_members.push_back(module_bundle_member{
+            std::move(name),
+            bytes.subspan(offset, size),
+            std::make_shared<const module_manifest_entry>(module_manifest_entry{
+                file_identity{},
+                std::move(build_id),
+                module_info{std::move(author),
+                            std::move(module_name),
+                            std::move(version),
+                            std::move(description)},
+                {}})});
+    }
+
+    if (reader.failed())
+    {
+        throw exception::dynamic_loader_error("malformed module bundle index (path: {})",
+                                              m_path);
+    }
+}
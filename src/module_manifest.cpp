@@ -0,0 +1,270 @@
+#include <cstring>
+#include <mi/binary_stream.hpp>
+#include <mi/elf_image.hpp>
+#include <mi/fs_error.hpp>
+#include <mi/mapped_file.hpp>
+#include <mi/module_manifest.hpp>
+#include <mi/os.hpp>
+#include <mutex>
+
+#ifdef MI_OS_UNIX_LIKE
+#    include <sys/stat.h>
+#endif
+
+using namespace mi;
+
+namespace
+{
+
+constexpr char          MANIFEST_MAGIC[4] = {'M', 'I', 'M', 'F'}; ///< File signature.
+constexpr std::uint32_t MANIFEST_VERSION  = 1;          ///< Layout of the file.
+constexpr std::uint32_t MANIFEST_ORDER    = 0x01020304; ///< Detects the byte order.
+
+/**
+ * @brief Returns the key of a module path in the manifest.
+ */
+std::string
+manifest_key(const fs::path_t &path)
+{
+    const auto key = path.lexically_normal().u8string();
+    return {reinterpret_cast<const char *>(key.data()), key.size()};
+}
+
+} // namespace
+
+std::optional<file_identity>
+file_identity::of(const fs::path_t &path) noexcept
+{
+#ifdef MI_OS_UNIX_LIKE
+    struct stat status{};
+    if (::stat(path.c_str(), &status) != 0)
+    {
+        return std::nullopt;
+    }
+
+#    ifdef MI_OS_LINUX
+    const auto seconds     = status.st_mtim.tv_sec;
+    const auto nanoseconds = status.st_mtim.tv_nsec;
+#    else
+    const auto seconds     = status.st_mtimespec.tv_sec;
+    const auto nanoseconds = status.st_mtimespec.tv_nsec;
+#    endif
+    return file_identity{static_cast<std::uint64_t>(status.st_dev),
+                         static_cast<std::uint64_t>(status.st_ino),
+                         static_cast<std::uint64_t>(status.st_size),
+                         static_cast<std::uint64_t>(seconds) * 1000000000u +
+                             static_cast<std::uint64_t>(nanoseconds)};
+#else
+    std::error_code error;
+    const auto      size = std::filesystem::file_size(path, error);
+    if (error)
+    {
+        return std::nullopt;
+    }
+
+    const auto time = std::filesystem::last_write_time(path, error);
+    if (error)
+    {
+        return std::nullopt;
+    }
+    return file_identity{
+        0,
+        0,
+        static_cast<std::uint64_t>(size),
+        static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch())
+                .count())};
+#endif
+}
+
+std::size_t
+module_manifest::size() const
+{
+    std::shared_lock lock(m_mutex);
+    return m_entries.size();
+}
+
+bool
+module_manifest::is_modified() const
+{
+    std::shared_lock lock(m_mutex);
+    return m_generation != m_saved_generation;
+}
+
+std::shared_ptr<const module_manifest_entry>
+module_manifest::find(const fs::path_t &path) const
+{
+    std::shared_ptr<const module_manifest_entry> entry;
+    {
+        std::shared_lock lock(m_mutex);
+        if (auto found = m_entries.find(manifest_key(path)); found != m_entries.end())
+        {
+            entry = found->second;
+        }
+    }
+
+    if (entry != nullptr && file_identity::of(path) == entry->identity)
+    {
+        return entry;
+    }
+    return nullptr;
+}
+
+void
+module_manifest::record(const fs::path_t &path, const module_info &info)
+{
+    const auto identity = file_identity::of(path);
+    if (!identity.has_value() || find(path) != nullptr)
+    {
+        return;
+    }
+
+    auto entry = std::make_shared<module_manifest_entry>(
+        module_manifest_entry{*identity, {}, info, {}});
+
+    try
+    {
+        const fs::mapped_file file(path);
+        const dl::elf_image   image(file.bytes());
+
+        const auto build_id = image.build_id();
+        entry->build_id.assign(reinterpret_cast<const char *>(build_id.data()),
+                               build_id.size());
+        for (auto name : image.exported_symbols())
+        {
+            entry->symbols.emplace_back(name);
+        }
+    }
+    catch (const std::exception &)
+    {
+        /// The file is described without its build identifier and symbols.
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_entries.insert_or_assign(manifest_key(path), std::move(entry));
+    ++m_generation;
+}
+
+void
+module_manifest::save()
+{
+    /// Saves are serialized, so that an older snapshot never replaces a newer one.
+    std::lock_guard save_lock(m_save_mutex);
+
+    binary_writer writer;
+    std::uint64_t generation = 0;
+    {
+        std::shared_lock lock(m_mutex);
+        if (m_generation == m_saved_generation)
+        {
+            return;
+        }
+
+        generation = m_generation;
+
+        writer.bytes(std::string_view(MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC)));
+        writer.u32(MANIFEST_VERSION);
+        writer.u32(MANIFEST_ORDER);
+        writer.u32(static_cast<std::uint32_t>(m_entries.size()));
+
+        for (const auto &[key, entry] : m_entries)
+        {
+            writer.string(key);
+            writer.u64(entry->identity.device);
+            writer.u64(entry->identity.inode);
+            writer.u64(entry->identity.size);
+            writer.u64(entry->identity.mtime);
+            writer.string(entry->build_id);
+            writer.string(entry->info.author);
+            writer.string(entry->info.name);
+            writer.string(entry->info.version);
+            writer.string(entry->info.description);
+            writer.u32(static_cast<std::uint32_t>(entry->symbols.size()));
+            for (const auto &symbol : entry->symbols)
+            {
+                writer.string(symbol);
+            }
+        }
+    }
+
+    fs::replace_file(m_path, writer.buffer());
+
+    /// Entries recorded since the snapshot stay modified.
+    std::lock_guard lock(m_mutex);
+    m_saved_generation = generation;
+}
+
+bool
+module_manifest::parse(std::span<const std::byte> bytes)
+{
+    if (bytes.size() < sizeof(MANIFEST_MAGIC) ||
+        std::memcmp(bytes.data(), MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    binary_reader reader(bytes.subspan(sizeof(MANIFEST_MAGIC)));
+    if (reader.u32() != MANIFEST_VERSION || reader.u32() != MANIFEST_ORDER)
+    {
+        return false;
+    }
+
+    const auto count = reader.u32();
+    for (std::uint32_t index = 0; index < count && !reader.failed(); ++index)
+    {
+        auto          key = reader.string();
+        file_identity identity;
+        identity.device = reader.u64();
+        identity.inode  = reader.u64();
+        identity.size   = reader.u64();
+        identity.mtime  = reader.u64();
+
+        auto build_id    = reader.string();
+        auto author      = reader.string();
+        auto name        = reader.string();
+        auto version     = reader.string();
+        auto description = reader.string();
+
+        std::vector<std::string> symbols;
+        const auto               symbol_count = reader.u32();
+        for (std::uint32_t symbol = 0; symbol < symbol_count && !reader.failed();
+             ++symbol)
+        {
+            symbols.push_back(reader.string());
+        }
+
+        m_entries.insert_or_assign(
+            std::move(key),
+            std::make_shared<const module_manifest_entry>(module_manifest_entry{
+                identity,
+                std::move(build_id),
+                module_info{std::move(author),
+                            std::move(name),
+                            std::move(version),
+                            std::move(description)},
+                std::move(symbols)}));
+    }
+
+    return !reader.failed() && reader.at_end();
+}
+
+module_manifest::module_manifest(fs::path_t path)
+    : m_path(std::move(path))
+{
+    try
+    {
+        if (std::filesystem::is_regular_file(m_path))
+        {
+            const fs::mapped_file file(m_path);
+            if (!parse(file.bytes()))
+            {
+                m_entries.clear();
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        /// An unreadable manifest is treated as empty.
+        m_entries.clear();
+    }
+}
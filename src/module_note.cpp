@@ -0,0 +1,78 @@
+#include <mi/elf_image.hpp>
+#include <mi/mapped_file.hpp>
+#include <mi/module_note.hpp>
+
+#ifdef MI_OS_LINUX
+#    include <cstring>
+#    include <elf.h>
+#endif
+
+using namespace mi;
+
+std::optional<module_info>
+dl::read_module_info(std::span<const std::byte> bytes) noexcept
+{
+#ifdef MI_OS_LINUX
+    if (bytes.size() < SELFMAG || std::memcmp(bytes.data(), ELFMAG, SELFMAG) != 0)
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        const elf_image image(bytes);
+        const auto      desc = image.note(std::string_view(note::MODULE_INFO_OWNER),
+                                     note::MODULE_INFO_TYPE);
+
+        std::uint32_t layout = 0;
+        if (desc.size() < sizeof(layout))
+        {
+            return std::nullopt;
+        }
+
+        std::memcpy(&layout, desc.data(), sizeof(layout));
+        if (layout != note::MODULE_INFO_LAYOUT)
+        {
+            return std::nullopt;
+        }
+
+        std::string_view strings(reinterpret_cast<const char *>(desc.data()) +
+                                     sizeof(layout),
+                                 desc.size() - sizeof(layout));
+        std::string_view fields[4];
+        for (auto &field : fields)
+        {
+            const auto end = strings.find('\0');
+            if (end == std::string_view::npos)
+            {
+                return std::nullopt;
+            }
+            field   = strings.substr(0, end);
+            strings = strings.substr(end + 1);
+        }
+        return module_info{std::string(fields[0]),
+                           std::string(fields[1]),
+                           std::string(fields[2]),
+                           std::string(fields[3])};
+    }
+    catch (const std::exception &)
+    {
+        /// A malformed image carries no usable note.
+    }
+#endif
+    return std::nullopt;
+}
+
+std::optional<module_info>
+dl::read_module_info(const fs::path_t &path) noexcept
+{
+    try
+    {
+        const fs::mapped_file file(path);
+        return read_module_info(file.bytes());
+    }
+    catch (const std::exception &)
+    {
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <mi/module_watcher.hpp>
+
+#ifdef MI_OS_LINUX
+#    include <poll.h>
+#    include <sys/eventfd.h>
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#endif
+
+using namespace mi;
+
+#ifdef MI_OS_LINUX
+
+module_watcher::module_watcher(exception::handler_t handler)
+    : m_handler(std::move(handler))
+{
+    m_notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_notify < 0 || m_wakeup < 0)
+    {
+        const auto message = os::last_error_message();
+        ::close(m_notify);
+        ::close(m_wakeup);
+        throw exception::dynamic_loader_error("failed to create module watcher ({})",
+                                              message);
+    }
+    m_thread = std::thread(&module_watcher::run, this);
+}
+
+module_watcher::~module_watcher()
+{
+    const std::uint64_t value = 1;
+    [[maybe_unused]] auto written = ::write(m_wakeup, &value, sizeof(value));
+    m_thread.join();
+
+    ::close(m_notify);
+    ::close(m_wakeup);
+}
+
+void
+module_watcher::watch(dynamic_module &module)
+{
+    std::lock_guard lock(m_mutex);
+    if (std::any_of(m_entries.begin(),
+                    m_entries.end(),
+                    [&module](const entry &entry)
+                    {
+                        return entry.module == &module;
+                    }))
+    {
+        return;
+    }
+
+    const auto path = std::filesystem::absolute(module.path());
+
+    /// Renaming a new version into place replaces the directory entry,
+    /// so the directory is watched rather than the file itself.
+    const int watch = inotify_add_watch(m_notify,
+                                        path.parent_path().c_str(),
+                                        IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch < 0)
+    {
+        throw exception::dynamic_loader_error(
+            "failed to watch module (path: {}, error: {})",
+            path,
+            os::last_error_message());
+    }
+    m_entries.push_back({&module, watch, path.filename()});
+}
+
+void
+module_watcher::unwatch(dynamic_module &module) noexcept
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = std::find_if(m_entries.begin(),
+                              m_entries.end(),
+                              [&module](const entry &entry)
+                              {
+                                  return entry.module == &module;
+                              });
+    if (found == m_entries.end())
+    {
+        return;
+    }
+
+    const int watch = found->watch;
+    m_entries.erase(found);
+
+    /// inotify returns the same watch for the same directory.
+    if (std::none_of(m_entries.begin(),
+                     m_entries.end(),
+                     [watch](const entry &entry)
+                     {
+                         return entry.watch == watch;
+                     }))
+    {
+        inotify_rm_watch(m_notify, watch);
+    }
+}
+
+void
+module_watcher::run()
+{
+    alignas(inotify_event) char buffer[4096];
+
+    pollfd descriptors[] = {
+        {m_notify, POLLIN, 0},
+        {m_wakeup, POLLIN, 0},
+    };
+
+    for (;;)
+    {
+        if (::poll(descriptors, 2, -1) < 0)
+        {
+            continue;
+        }
+        else if (descriptors[1].revents != 0)
+        {
+            return;
+        }
+
+        for (;;)
+        {
+            const auto size = ::read(m_notify, buffer, sizeof(buffer));
+            if (size <= 0)
+            {
+                break;
+            }
+            dispatch(buffer, static_cast<std::size_t>(size));
+        }
+    }
+}
+
+void
+module_watcher::dispatch(const char *events, std::size_t size)
+{
+    std::lock_guard lock(m_mutex);
+
+    /// A batch may hold several events for the same file,
+    /// every affected module is reloaded once.
+    std::vector<dynamic_module *> modules;
+    for (std::size_t offset = 0; offset < size;)
+    {
+        const auto *event = reinterpret_cast<const inotify_event *>(events + offset);
+        offset += sizeof(inotify_event) + event->len;
+
+        if (event->len == 0)
+        {
+            continue;
+        }
+
+        const fs::path_t filename(event->name);
+        for (const auto &entry : m_entries)
+        {
+            if (entry.watch == event->wd && entry.filename == filename &&
+                std::find(modules.begin(), modules.end(), entry.module) == modules.end())
+            {
+                modules.push_back(entry.module);
+            }
+        }
+    }
+
+    for (auto *module : modules)
+    {
+        /// A pending module loads the current file on first use anyway.
+        if (module->is_pending())
+        {
+            continue;
+        }
+        exception::invoke_and_catch(m_handler, &dynamic_module::reload, module);
+    }
+}
+
+#else
+
+module_watcher::module_watcher(exception::handler_t handler)
+    : m_handler(std::move(handler))
+{
+}
+
+module_watcher::~module_watcher() = default;
+
+void
+module_watcher::watch(dynamic_module &module)
+{
+    throw exception::dynamic_loader_error(
+        "module watching is not supported on this platform (path: {})",
+        module.path());
+}
+
+void
+module_watcher::unwatch(dynamic_module &) noexcept
+{
+}
+
+void
+module_watcher::run()
+{
+}
+
+void
+module_watcher::dispatch(const char *, std::size_t)
+{
+}
+
+#endif
@@ -0,0 +1,347 @@
+#include <mi/preflight.hpp>
+
+#ifdef MI_OS_LINUX
+#    include <algorithm>
+#    include <cstdlib>
+#    include <cstring>
+#    include <elf.h>
+#    include <link.h>
+#    include <mi/elf_image.hpp>
+#    include <mi/fs_error.hpp>
+#    include <mi/mapped_file.hpp>
+#    include <string>
+#    include <unordered_set>
+#endif
+
+using namespace mi;
+using namespace mi::dl;
+
+#ifdef MI_OS_LINUX
+
+namespace
+{
+
+/**
+ * @brief Returns the library names listed in the ld.so cache.
+ *
+ * The cache is read once per process, only the format written
+ * by glibc 2.32 and newer ("glibc-ld.so.cache1.1") is understood.
+ */
+const std::unordered_set<std::string> &
+cached_libraries()
+{
+    static const auto libraries = []()
+    {
+        std::unordered_set<std::string> names;
+        try
+        {
+            const fs::mapped_file  file("/etc/ld.so.cache");
+            const auto *data = reinterpret_cast<const char *>(file.bytes().data());
+            const std::string_view contents(data, file.size());
+
+            constexpr std::string_view magic("glibc-ld.so.cache1.1");
+            const auto                 header = contents.find(magic);
+            if (header == std::string_view::npos || header % 4 != 0 ||
+                contents.size() - header < 48)
+            {
+                return names;
+            }
+
+            std::uint32_t count = 0;
+            std::memcpy(&count, data + header + magic.size(), sizeof(count));
+
+            const auto entries = header + 48;
+            for (std::uint32_t index = 0; index < count; ++index)
+            {
+                const auto entry = entries + std::size_t(index) * 24;
+                if (entry + 24 > contents.size())
+                {
+                    break;
+                }
+
+                std::uint32_t key = 0;
+                std::memcpy(&key, data + entry + 4, sizeof(key));
+                if (header + key < contents.size())
+                {
+                    const auto name = contents.substr(header + key);
+                    names.emplace(name.substr(0, name.find('\0')));
+                }
+            }
+        }
+        catch (const exception::fs_error &)
+        {
+            /// Without a cache only the search paths are consulted.
+        }
+        return names;
+    }();
+    return libraries;
+}
+
+/**
+ * @brief Checks whether a library exists in any directory of a search path.
+ *
+ * @param search_path The colon-separated list of directories.
+ * @param origin The directory of the library being validated,
+ *               substituted for $ORIGIN.
+ *
+ * @param name The name of the needed library.
+ */
+bool
+found_in(std::string_view search_path, const fs::path_t &origin, std::string_view name)
+{
+    while (!search_path.empty())
+    {
+        const auto separator = search_path.find(':');
+        std::string directory(search_path.substr(0, separator));
+        search_path = separator == std::string_view::npos
+                          ? std::string_view()
+                          : search_path.substr(separator + 1);
+
+        for (std::string_view token : {"${ORIGIN}", "$ORIGIN"})
+        {
+            for (auto position = directory.find(token); position != std::string::npos;
+                 position      = directory.find(token))
+            {
+                directory.replace(position, token.size(), origin.string());
+            }
+        }
+
+        std::error_code error;
+        if (!directory.empty() &&
+            std::filesystem::is_regular_file(fs::path_t(directory) / name, error))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @struct loaded_query
+ * @brief Parameters and result of the search for a loaded library.
+ */
+struct loaded_query
+{
+    std::string_view name;  ///< The needed name of the library.
+    bool             found; ///< Set if a loaded object goes by the name.
+};
+
+/**
+ * @brief Checks whether a loaded object goes by the name of a query,
+ *        either by the name of its file or by its DT_SONAME.
+ */
+int
+find_loaded(struct dl_phdr_info *info, size_t, void *data)
+{
+    auto                  *query = static_cast<loaded_query *>(data);
+    const std::string_view path(info->dlpi_name != nullptr ? info->dlpi_name : "");
+    if (!path.empty() && path.substr(path.rfind('/') + 1) == query->name)
+    {
+        query->found = true;
+        return 1;
+    }
+
+    for (ElfW(Half) index = 0; index < info->dlpi_phnum; ++index)
+    {
+        if (info->dlpi_phdr[index].p_type != PT_DYNAMIC)
+        {
+            continue;
+        }
+
+        const auto *entry = reinterpret_cast<const ElfW(Dyn) *>(
+            info->dlpi_addr + info->dlpi_phdr[index].p_vaddr);
+
+        ElfW(Addr)  strtab = 0;
+        ElfW(Xword) soname = 0;
+        bool        named  = false;
+        for (; entry->d_tag != DT_NULL; ++entry)
+        {
+            if (entry->d_tag == DT_STRTAB)
+            {
+                strtab = entry->d_un.d_ptr;
+            }
+            else if (entry->d_tag == DT_SONAME)
+            {
+                soname = entry->d_un.d_val;
+                named  = true;
+            }
+        }
+
+        if (named && strtab != 0)
+        {
+            /// Depending on the architecture the dynamic linker may or may not
+            /// have relocated the pointers stored in the dynamic section.
+            const auto *strings = reinterpret_cast<const char *>(
+                strtab < info->dlpi_addr ? info->dlpi_addr + strtab : strtab);
+            if (query->name == strings + soname)
+            {
+                query->found = true;
+                return 1;
+            }
+        }
+        break;
+    }
+    return 0;
+}
+
+/**
+ * @brief Checks whether the dynamic linker would find a needed library.
+ */
+bool
+is_resolvable(const elf_image &image, const fs::path_t &origin, std::string_view name)
+{
+    const std::string library(name);
+    if (library.find('/') != std::string::npos)
+    {
+        std::error_code error;
+        return std::filesystem::is_regular_file(library, error);
+    }
+
+    /// Loaded objects are walked rather than probed with dlopen(RTLD_NOLOAD),
+    /// which would touch the reference counts and the dlerror state
+    /// seen by loads running concurrently.
+    loaded_query query{name, false};
+    dl_iterate_phdr(&find_loaded, &query);
+    if (query.found)
+    {
+        return true;
+    }
+
+    const auto *environment = std::getenv("LD_LIBRARY_PATH");
+    return (image.runpath().empty() && found_in(image.rpath(), origin, name)) ||
+           (environment != nullptr && found_in(environment, origin, name)) ||
+           found_in(image.runpath(), origin, name) ||
+           cached_libraries().contains(library) ||
+           found_in("/lib:/usr/lib:/lib64:/usr/lib64", origin, name);
+}
+
+/**
+ * @brief Appends a name to a comma-separated list.
+ */
+void
+append(std::string &list, std::string_view name)
+{
+    list += list.empty() ? "" : ", ";
+    list += name;
+}
+
+} // namespace
+
+result<void>
+dl::try_preflight(const fs::path_t                 &path,
+                  std::span<const std::string_view> required_symbols)
+{
+    try
+    {
+        const fs::mapped_file file(path);
+        return dl::try_preflight(path, file.bytes(), required_symbols);
+    }
+    catch (const exception::fs_error &error)
+    {
+        return dl::error(errc::no_read_access, path, error.what());
+    }
+}
+
+result<void>
+dl::try_preflight(const fs::path_t                 &path,
+                  std::span<const std::byte>        bytes,
+                  std::span<const std::string_view> required_symbols)
+{
+    /// Checked upfront, most foreign files are rejected without an exception.
+    if (bytes.size() < SELFMAG || std::memcmp(bytes.data(), ELFMAG, SELFMAG) != 0)
+    {
+        return dl::error(errc::not_elf, path);
+    }
+
+    try
+    {
+        const elf_image image(bytes);
+        if (!image.is_loadable())
+        {
+            return dl::error(errc::not_loadable,
+                             path,
+                             "type: " + std::to_string(image.type()) +
+                                 ", machine: " + std::to_string(image.machine()));
+        }
+
+        std::string missing;
+        if (!required_symbols.empty())
+        {
+            const auto symbols = image.exported_symbols();
+            for (const auto &name : required_symbols)
+            {
+                if (std::find(symbols.begin(), symbols.end(), name) == symbols.end())
+                {
+                    append(missing, name);
+                }
+            }
+        }
+
+        if (!missing.empty())
+        {
+            return dl::error(errc::missing_symbols, path, std::move(missing));
+        }
+
+        const auto origin = std::filesystem::absolute(path).parent_path();
+        for (const auto &name : image.needed())
+        {
+            if (!is_resolvable(image, origin, name))
+            {
+                append(missing, name);
+            }
+        }
+
+        if (!missing.empty())
+        {
+            return dl::error(errc::unresolved_dependencies, path, std::move(missing));
+        }
+    }
+    catch (const exception::dynamic_library_error &error)
+    {
+        /// Thrown by the image for malformed files and foreign ELF classes.
+        return dl::error(errc::malformed, path, error.what());
+    }
+    return {};
+}
+
+void
+dl::preflight(const fs::path_t &path, std::span<const std::string_view> required_symbols)
+{
+    try_preflight(path, required_symbols).value();
+}
+
+void
+dl::preflight(const fs::path_t                 &path,
+              std::span<const std::byte>        bytes,
+              std::span<const std::string_view> required_symbols)
+{
+    try_preflight(path, bytes, required_symbols).value();
+}
+
+#else
+
+void
+dl::preflight(const fs::path_t &, std::span<const std::string_view>)
+{
+}
+
+void
+dl::preflight(const fs::path_t &, std::span<const std::byte>, std::span<const std::string_view>)
+{
+}
+
+result<void>
+dl::try_preflight(const fs::path_t &, std::span<const std::string_view>)
+{
+    return {};
+}
+
+result<void>
+dl::try_preflight(const fs::path_t &,
+                  std::span<const std::byte>,
+                  std::span<const std::string_view>)
+{
+    return {};
+}
+
+#endif
\ No newline at end of file
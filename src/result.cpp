@@ -0,0 +1,108 @@
+#include <mi/dynamic_library_error.hpp>
+#include <mi/result.hpp>
+
+using namespace mi;
+using namespace mi::dl;
+
+namespace
+{
+
+/**
+ * @struct errc_text
+ * @brief How the message of an error code is composed.
+ */
+struct errc_text
+{
+    std::string_view text;  ///< The description of the code.
+    std::string_view label; ///< Names the detail in the message, empty if unnamed.
+};
+
+/**
+ * @brief Returns how the message of an error code is composed.
+ */
+constexpr errc_text
+text_of(errc code) noexcept
+{
+    switch (code)
+    {
+    case errc::invalid_extension:
+        return {"invalid extension", {}};
+    case errc::already_loaded:
+        return {"already loaded", {}};
+    case errc::not_loaded:
+        return {"dynamic library is not loaded", "symbol"};
+    case errc::no_read_access:
+        return {"no read access", "error"};
+    case errc::not_regular_file:
+        return {"not a regular file", {}};
+    case errc::empty_file:
+        return {"empty file", {}};
+    case errc::empty_image:
+        return {"empty image", {}};
+    case errc::memory_file_failed:
+        return {"failed to create memory file", "error"};
+    case errc::unsupported:
+        return {"not supported on this platform", {}};
+    case errc::not_elf:
+        return {"not an ELF file", {}};
+    case errc::malformed:
+        return {"malformed ELF file", {}};
+    case errc::not_loadable:
+        return {"not a shared object for this machine", {}};
+    case errc::missing_symbols:
+        return {"missing required symbols", "symbols"};
+    case errc::unresolved_dependencies:
+        return {"unresolved dependencies", "libraries"};
+    case errc::open_failed:
+        return {"failed to open", {}};
+    case errc::close_failed:
+        return {"failed to close", "error"};
+    case errc::symbol_not_found:
+        return {"no function from dynamic library", "function"};
+    case errc::modules_failed:
+        return {"failed to load modules", "error"};
+    }
+    return {"unknown error", {}};
+}
+
+} // namespace
+
+std::string_view
+dl::to_string(errc code) noexcept
+{
+    return text_of(code).text;
+}
+
+std::string
+error::message() const
+{
+    /// The platform loader reports complete messages, naming the file itself.
+    if (m_code == errc::open_failed && !m_detail.empty())
+    {
+        return m_detail;
+    }
+
+    /// The image describes its own errors, the detail replaces the description.
+    auto [text, label] = text_of(m_code);
+    auto detail        = std::string_view(m_detail);
+    if (m_code == errc::malformed)
+    {
+        text = detail.empty() ? text : std::exchange(detail, {});
+    }
+
+    std::string subject;
+    if (!detail.empty())
+    {
+        subject.append(label).append(label.empty() ? "" : ": ").append(detail).append(", ");
+    }
+    return format::interpolate_string(std::string_view("{} ({}path: {})"),
+                                      text,
+                                      subject,
+                                      *m_path);
+}
+
+void
+error::raise() const
+{
+    throw exception::dynamic_library_error("{}", message());
+}
@@ -0,0 +1,90 @@
+#include <mi/symbol_cache.hpp>
+
+using namespace mi;
+using namespace mi::dl;
+
+namespace
+{
+
+/**
+ * @brief The maximum number of entries, keeps probe sequences short.
+ */
+constexpr std::size_t LOAD_LIMIT = symbol_cache::CAPACITY / 4 * 3;
+
+} // namespace
+
+os::dynamic_library_func_t
+symbol_cache::find(const symbol &symbol) const noexcept
+{
+    auto index = symbol.hash() & (CAPACITY - 1);
+    for (std::size_t probe = 0; probe < CAPACITY; ++probe)
+    {
+        const auto *entry = m_slots[index].load(std::memory_order_acquire);
+        if (entry == nullptr)
+        {
+            break;
+        }
+        else if (entry->hash == symbol.hash() && entry->name == symbol.name())
+        {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->address;
+        }
+        index = (index + 1) & (CAPACITY - 1);
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void
+symbol_cache::insert(const symbol &symbol, os::dynamic_library_func_t address)
+{
+    if (address == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (m_entries.size() >= LOAD_LIMIT)
+    {
+        return;
+    }
+
+    auto index = symbol.hash() & (CAPACITY - 1);
+    for (;;)
+    {
+        const auto *entry = m_slots[index].load(std::memory_order_relaxed);
+        if (entry == nullptr)
+        {
+            break;
+        }
+        else if (entry->hash == symbol.hash() && entry->name == symbol.name())
+        {
+            /// Another thread has cached the symbol in the meantime.
+            return;
+        }
+        index = (index + 1) & (CAPACITY - 1);
+    }
+
+    const auto &entry = m_entries.emplace_back(
+        symbol_cache::entry{symbol.hash(), std::string(symbol.name()), address});
+    m_slots[index].store(&entry, std::memory_order_release);
+}
+
+void
+symbol_cache::clear()
+{
+    std::lock_guard lock(m_mutex);
+    for (auto &slot : m_slots)
+    {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+    m_entries.clear();
+}
+
+symbol_cache_stats
+symbol_cache::stats() const noexcept
+{
+    return {m_hits.load(std::memory_order_relaxed),
+            m_misses.load(std::memory_order_relaxed)};
+}
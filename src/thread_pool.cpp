@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <mi/thread_pool.hpp>
+
+using namespace mi;
+
+namespace
+{
+
+/**
+ * @struct current_worker
+ * @brief Identifies the pool worker running on the calling thread.
+ */
+struct current_worker
+{
+    const thread_pool *pool  = nullptr; ///< The pool, nullptr outside of workers.
+    std::size_t        index = 0;       ///< The index of the worker.
+};
+
+thread_local current_worker current;
+
+} // namespace
+
+void
+thread_pool::submit(task_t task)
+{
+    if (current.pool == this)
+    {
+        push(current.index, std::move(task));
+        return;
+    }
+    push(m_next.fetch_add(1, std::memory_order_relaxed) % size(), std::move(task));
+}
+
+void
+thread_pool::submit_affine(task_t task, std::size_t affinity)
+{
+    push(affinity % size(), std::move(task));
+}
+
+void
+thread_pool::wait()
+{
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock,
+                [this]()
+                {
+                    return m_pending.load(std::memory_order_acquire) == 0;
+                });
+}
+
+void
+thread_pool::push(std::size_t index, task_t task)
+{
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(m_queues[index].mutex);
+        m_queues[index].tasks.push_back(std::move(task));
+    }
+
+    /// Pairs with the sleeping worker, which counts itself before it checks
+    /// for queued tasks: either the worker sees the task or it is woken.
+    m_queued.fetch_add(1, std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_seq_cst) == 0)
+    {
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    /// Woken workers stop waiting and sleeping right away, so that further
+    /// tasks wake the other idle workers rather than the same one again.
+    auto *woken = m_queues[index].waiting ? &m_queues[index] : nullptr;
+    for (std::size_t other = 0; woken == nullptr && other < size(); ++other)
+    {
+        if (m_queues[other].waiting)
+        {
+            woken = &m_queues[other];
+        }
+    }
+
+    if (woken != nullptr)
+    {
+        woken->waiting = false;
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+        woken->wakeup.notify_one();
+    }
+}
+
+thread_pool::task_t
+thread_pool::take(std::size_t index)
+{
+    task_t task;
+    if (m_queued.load(std::memory_order_relaxed) == 0)
+    {
+        return task;
+    }
+
+    {
+        auto           &own = m_queues[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+        }
+    }
+
+    for (std::size_t offset = 1; !task && offset < size(); ++offset)
+    {
+        auto           &other = m_queues[(index + offset) % size()];
+        std::lock_guard lock(other.mutex);
+        if (!other.tasks.empty())
+        {
+            task = std::move(other.tasks.back());
+            other.tasks.pop_back();
+        }
+    }
+
+    if (task)
+    {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+void
+thread_pool::execute(task_t &task) noexcept
+{
+    try
+    {
+        task();
+    }
+    catch (const std::exception &exception)
+    {
+        if (m_handler)
+        {
+            m_handler(exception);
+        }
+    }
+    catch (...)
+    {
+        /// Exceptions of other types carry nothing to report.
+    }
+}
+
+void
+thread_pool::run(std::size_t index)
+{
+    current = {this, index};
+
+    auto &queue = m_queues[index];
+    for (;;)
+    {
+        if (auto task = take(index))
+        {
+            execute(task);
+            task = nullptr;
+
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard lock(m_mutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(m_mutex);
+        queue.waiting = true;
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        queue.wakeup.wait(lock,
+                          [this, &queue]()
+                          {
+                              return m_stopped || !queue.waiting ||
+                                     m_queued.load(std::memory_order_seq_cst) != 0;
+                          });
+        if (queue.waiting)
+        {
+            queue.waiting = false;
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        if (m_stopped && m_queued.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+    }
+}
+
+thread_pool::thread_pool(std::size_t workers, exception::handler_t handler)
+    : m_size(workers != 0 ? workers : std::max(1U, std::thread::hardware_concurrency())),
+      m_queues(std::make_unique<worker_queue[]>(m_size)),
+      m_handler(std::move(handler))
+{
+    m_workers.reserve(m_size);
+    for (std::size_t index = 0; index < m_size; ++index)
+    {
+        m_workers.emplace_back(&thread_pool::run, this, index);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    wait();
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopped = true;
+        for (std::size_t index = 0; index < size(); ++index)
+        {
+            m_queues[index].wakeup.notify_all();
+        }
+    }
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+}
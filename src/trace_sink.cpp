@@ -0,0 +1,20 @@
+#include <mi/trace_sink.hpp>
+
+using namespace mi;
+using namespace mi::trace;
+
+void
+trace_scope::emit(void (trace_sink::*receiver)(const trace_event &)) noexcept
+{
+    try
+    {
+        (m_sink->*receiver)(trace_event{m_name,
+                                        m_path,
+                                        std::this_thread::get_id(),
+                                        std::chrono::steady_clock::now()});
+    }
+    catch (...)
+    {
+        /// Tracing never fails the traced operation.
+    }
+}